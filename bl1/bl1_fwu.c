@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <context.h>
 #include <drivers/auth/auth_mod.h>
+#include <drivers/auth/crypto_mod.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -52,6 +53,22 @@ __dead2 static void bl1_fwu_done(void *client_cookie, void *reserved);
  */
 static unsigned int sec_exec_image_id = INVALID_IMAGE_ID;
 
+#if BL1_FWU_STREAM_HASH
+/*
+ * Hash of a secure image, calculated block by block while the image is copied
+ * so that its authentication doesn't need to read the whole image again. The
+ * crypto library can only hash one image at a time.
+ */
+static struct {
+	unsigned int image_id;	/* Image being hashed, or INVALID_IMAGE_ID */
+	bool done;		/* Whole image hashed */
+	unsigned int hash_len;
+	unsigned char hash[CRYPTO_MAX_HASH_SIZE];
+} bl1_fwu_hash = {
+	.image_id = INVALID_IMAGE_ID
+};
+#endif
+
 /*******************************************************************************
  * Top level handler for servicing FWU SMCs.
  ******************************************************************************/
@@ -218,6 +235,52 @@ static int bl1_fwu_image_check_overlaps(unsigned int image_id)
 	return 0;
 }
 
+#if BL1_FWU_STREAM_HASH
+/*******************************************************************************
+ * Add a block of a secure image, already copied in secure memory, to the hash
+ * of that image. The hash is started with the first block and completed with
+ * the last one. If the hash can't be calculated, the image is hashed again
+ * when it is authenticated.
+ ******************************************************************************/
+static void bl1_fwu_hash_block(unsigned int image_id, const image_desc_t *desc,
+			       uintptr_t block_addr, unsigned int block_size)
+{
+	if (desc->copied_size == 0U) {
+		/* Don't interrupt the hash of an image still being copied. */
+		if ((bl1_fwu_hash.image_id != INVALID_IMAGE_ID) &&
+		    !bl1_fwu_hash.done) {
+			return;
+		}
+
+		bl1_fwu_hash.image_id = INVALID_IMAGE_ID;
+		if (crypto_mod_hash_stream_start() != 0) {
+			return;
+		}
+
+		bl1_fwu_hash.image_id = image_id;
+		bl1_fwu_hash.done = false;
+	} else if ((bl1_fwu_hash.image_id != image_id) || bl1_fwu_hash.done) {
+		return;
+	}
+
+	if (crypto_mod_hash_stream_update((const void *)block_addr,
+					  block_size) != 0) {
+		bl1_fwu_hash.image_id = INVALID_IMAGE_ID;
+		return;
+	}
+
+	if ((desc->copied_size + block_size) == desc->image_info.image_size) {
+		if (crypto_mod_hash_stream_finish(bl1_fwu_hash.hash,
+						  &bl1_fwu_hash.hash_len) != 0) {
+			bl1_fwu_hash.image_id = INVALID_IMAGE_ID;
+			return;
+		}
+
+		bl1_fwu_hash.done = true;
+	}
+}
+#endif /* BL1_FWU_STREAM_HASH */
+
 /*******************************************************************************
  * This function is responsible for copying secure images in AP Secure RAM.
  ******************************************************************************/
@@ -353,6 +416,14 @@ static int bl1_fwu_image_copy(unsigned int image_id,
 	(void)memcpy((void *) dest_addr, (const void *) image_src, block_size);
 	flush_dcache_range(dest_addr, block_size);
 
+#if BL1_FWU_STREAM_HASH
+	/*
+	 * Hash the secure copy rather than the source, which the non-secure
+	 * world could modify after it has been copied.
+	 */
+	bl1_fwu_hash_block(image_id, desc, dest_addr, block_size);
+#endif
+
 	desc->copied_size += block_size;
 	desc->state = (block_size == remaining) ?
 		IMAGE_STATE_COPIED : IMAGE_STATE_COPYING;
@@ -442,7 +513,21 @@ static int bl1_fwu_image_auth(unsigned int image_id,
 	 * Authenticate the image.
 	 */
 	INFO("BL1-FWU: Authenticating image_id:%d\n", image_id);
+#if BL1_FWU_STREAM_HASH
+	if ((desc->state == IMAGE_STATE_COPIED) &&
+	    (bl1_fwu_hash.image_id == image_id) && bl1_fwu_hash.done) {
+		/* The image has been hashed while it was copied. */
+		result = auth_mod_verify_img_hash(image_id, (void *)base_addr,
+						  total_size, bl1_fwu_hash.hash,
+						  bl1_fwu_hash.hash_len);
+		bl1_fwu_hash.image_id = INVALID_IMAGE_ID;
+	} else {
+		result = auth_mod_verify_img(image_id, (void *)base_addr,
+					     total_size);
+	}
+#else
 	result = auth_mod_verify_img(image_id, (void *)base_addr, total_size);
+#endif
 	if (result != 0) {
 		WARN("BL1-FWU: Authentication Failed err=%d\n", result);
 
@@ -725,6 +810,12 @@ static int bl1_fwu_image_reset(unsigned int image_id, unsigned int flags)
 					desc->copied_size);
 		}
 
+#if BL1_FWU_STREAM_HASH
+		if (bl1_fwu_hash.image_id == image_id) {
+			bl1_fwu_hash.image_id = INVALID_IMAGE_ID;
+		}
+#endif
+
 		/* Reset status variables */
 		desc->copied_size = 0;
 		desc->image_info.image_size = 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/console.h>
+#include <lib/boot_timeline/boot_timeline.h>
 #include <lib/cpus/errata_report.h>
 #include <lib/utils.h>
 #include <plat/common/platform.h>
@@ -79,6 +80,11 @@ void bl1_setup(void)
 void bl1_main(void)
 {
 	unsigned int image_id;
+	unsigned int tl_event;
+
+	/* Start the boot timeline */
+	boot_timeline_init();
+	tl_event = boot_timeline_begin(BOOT_TL_PHASE_STAGE, BOOT_TL_NO_IMAGE);
 
 	/* Announce our arrival */
 	NOTICE(FIRMWARE_WELCOME_STR);
@@ -153,6 +159,9 @@ void bl1_main(void)
 	/* Teardown the measured boot driver */
 	bl1_plat_mboot_finish();
 
+	boot_timeline_end(tl_event);
+	boot_timeline_flush();
+
 	bl1_prepare_next_image(image_id);
 
 	console_flush();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <drivers/auth/auth_mod.h>
 #include <drivers/console.h>
 #include <drivers/fwu/fwu.h>
+#include <lib/boot_timeline/boot_timeline.h>
 #include <lib/extensions/pauth.h>
 #include <plat/common/platform.h>
 
@@ -78,6 +79,10 @@ void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 void bl2_main(void)
 {
 	entry_point_info_t *next_bl_ep_info;
+	unsigned int tl_event;
+
+	boot_timeline_init();
+	tl_event = boot_timeline_begin(BOOT_TL_PHASE_STAGE, BOOT_TL_NO_IMAGE);
 
 	NOTICE("BL2: %s\n", version_string);
 	NOTICE("BL2: %s\n", build_message);
@@ -106,6 +111,10 @@ void bl2_main(void)
 	/* Teardown the Measured Boot backend */
 	bl2_plat_mboot_finish();
 
+	/* Hand the boot timeline over to the next stage */
+	boot_timeline_end(tl_event);
+	boot_timeline_flush();
+
 #if !BL2_AT_EL3 && !ENABLE_RME
 #ifndef __aarch64__
 	/*
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -59,6 +59,40 @@ ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
 
+ifeq (${EHF_INSTRUMENTATION},1)
+ifeq (${EL3_EXCEPTION_HANDLING},0)
+  $(error EL3_EXCEPTION_HANDLING must be 1 for EHF_INSTRUMENTATION support)
+endif
+ifeq (${ENABLE_PMF},0)
+  $(error ENABLE_PMF must be 1 for EHF_INSTRUMENTATION support)
+endif
+endif
+
+# The world switch events used by SECURE_TIME_INSTRUMENTATION and
+# NS_PROFILING_PAUSE are only published when EL3 switches the EL1 context,
+# which the SPMD does not do when the SPMC runs at S-EL2.
+ifeq (${SPD}-${SPMD_SPM_AT_SEL2},spmd-1)
+ifeq (${SECURE_TIME_INSTRUMENTATION},1)
+  $(error SECURE_TIME_INSTRUMENTATION is not supported with SPMD_SPM_AT_SEL2)
+endif
+ifeq (${NS_PROFILING_PAUSE},1)
+  $(error NS_PROFILING_PAUSE is not supported with SPMD_SPM_AT_SEL2)
+endif
+endif
+
+ifeq (${SECURE_TIME_INSTRUMENTATION},1)
+ifeq (${ENABLE_PMF},0)
+  $(error ENABLE_PMF must be 1 for SECURE_TIME_INSTRUMENTATION support)
+endif
+BL31_SOURCES		+=	bl31/secure_time_instr.c
+endif
+
+ifeq (${NS_PROFILING_PAUSE},1)
+ifeq ($(filter 1,${ENABLE_SPE_FOR_LOWER_ELS} ${ENABLE_TRBE_FOR_NS}),)
+  $(error ENABLE_SPE_FOR_LOWER_ELS or ENABLE_TRBE_FOR_NS must be 1 for NS_PROFILING_PAUSE support)
+endif
+endif
+
 ifeq (${SDEI_SUPPORT},1)
 ifeq (${EL3_EXCEPTION_HANDLING},0)
   $(error EL3_EXCEPTION_HANDLING must be 1 for SDEI support)
@@ -70,6 +104,16 @@ BL31_SOURCES		+=	services/std_svc/sdei/sdei_dispatch.S	\
 				services/std_svc/sdei/sdei_state.c
 endif
 
+ifeq (${SDEI_CONTEXT_BUFFER},1)
+ifeq (${SDEI_SUPPORT},0)
+  $(error SDEI_SUPPORT must be 1 for SDEI_CONTEXT_BUFFER support)
+endif
+endif
+
+ifeq (${TZC_TELEMETRY},1)
+BL31_SOURCES		+=	drivers/arm/tzc/tzc_telemetry.c
+endif
+
 ifeq (${TRNG_SUPPORT},1)
 BL31_SOURCES		+=	services/std_svc/trng/trng_main.c	\
 				services/std_svc/trng/trng_entropy_pool.c
@@ -98,6 +142,9 @@ endif
 
 ifeq (${ENABLE_MPAM_FOR_LOWER_ELS},1)
 BL31_SOURCES		+=	lib/extensions/mpam/mpam.c
+ifeq (${MPAM_PARTITIONING},1)
+BL31_SOURCES		+=	lib/extensions/mpam/mpam_msc.c
+endif
 endif
 
 ifeq (${ENABLE_TRBE_FOR_NS},1)
@@ -139,13 +186,21 @@ endif
 $(eval $(call assert_booleans,\
     $(sort \
 	CRASH_REPORTING \
+	EHF_INSTRUMENTATION \
 	EL3_EXCEPTION_HANDLING \
+	NS_PROFILING_PAUSE \
+	SDEI_CONTEXT_BUFFER \
 	SDEI_SUPPORT \
+	SECURE_TIME_INSTRUMENTATION \
 )))
 
 $(eval $(call add_defines,\
     $(sort \
         CRASH_REPORTING \
+        EHF_INSTRUMENTATION \
         EL3_EXCEPTION_HANDLING \
+        NS_PROFILING_PAUSE \
+        SDEI_CONTEXT_BUFFER \
         SDEI_SUPPORT \
+        SECURE_TIME_INSTRUMENTATION \
 )))
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,7 +16,13 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/console.h>
+#include <drivers/mmio_poll.h>
+#include <lib/boot_timeline/boot_timeline.h>
+#if CHIP_LOCAL_PERCPU_DATA
+#include <lib/el3_runtime/chip_local_percpu.h>
+#endif
 #include <lib/el3_runtime/context_mgmt.h>
+#include <lib/extensions/mpam.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
@@ -92,6 +98,11 @@ void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	/* Perform late platform-specific setup */
 	bl31_plat_arch_setup();
 
+#if CHIP_LOCAL_PERCPU_DATA
+	/* Prepare the chip-local per-cpu regions now that they are mapped */
+	chip_local_percpu_init();
+#endif
+
 #if ENABLE_FEAT_HCX
 	/*
 	 * Assert that FEAT_HCX is supported on this system, without this check
@@ -108,6 +119,14 @@ void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	 */
 	assert(is_armv8_3_pauth_present());
 #endif /* CTX_INCLUDE_PAUTH_REGS */
+
+#if MPAM_PARTITIONING
+	/*
+	 * Assert that MPAM is implemented, the MPAM0_EL1 and MPAM1_EL1
+	 * registers are saved and restored on world switches.
+	 */
+	assert(get_mpam_version() != 0U);
+#endif /* MPAM_PARTITIONING */
 }
 
 /*******************************************************************************
@@ -120,6 +139,11 @@ void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
  ******************************************************************************/
 void bl31_main(void)
 {
+	unsigned int tl_event;
+
+	boot_timeline_init();
+	tl_event = boot_timeline_begin(BOOT_TL_PHASE_STAGE, BOOT_TL_NO_IMAGE);
+
 	NOTICE("BL31: %s\n", version_string);
 	NOTICE("BL31: %s\n", build_message);
 
@@ -132,6 +156,11 @@ void bl31_main(void)
 	/* Perform platform setup in BL31 */
 	bl31_platform_setup();
 
+#if MPAM_PARTITIONING
+	/* Program the memory-system component partitions */
+	mpam_msc_init();
+#endif
+
 	/* Initialise helper libraries */
 	bl31_lib_init();
 
@@ -192,6 +221,13 @@ void bl31_main(void)
 	 */
 	bl31_prepare_next_image_entry();
 
+	/* Report the register polls performed during cold boot */
+	mmio_poll_stats_dump();
+
+	/* Report the timeline of the cold boot up to this point */
+	boot_timeline_end(tl_event);
+	boot_timeline_print();
+
 	console_flush();
 
 	/*
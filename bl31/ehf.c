@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,9 @@
 #include <stdbool.h>
 
 #include <bl31/ehf.h>
+#if EHF_INSTRUMENTATION
+#include <bl31/ehf_instr.h>
+#endif
 #include <bl31/interrupt_mgmt.h>
 #include <context.h>
 #include <common/debug.h>
@@ -50,6 +53,46 @@
 /* To be defined by the platform */
 extern const ehf_priorities_t exception_data;
 
+#if EHF_INSTRUMENTATION
+PMF_REGISTER_SERVICE_SMC(ehf_instr_svc, PMF_EHF_INSTR_SVC_ID,
+	EHF_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+
+/* Store the current counter value in the given EHF instrumentation slot */
+static unsigned long long ehf_instr_capture(unsigned int tid)
+{
+	unsigned long long ts;
+
+	PMF_CAPTURE_AND_GET_TIMESTAMP(ehf_instr_svc, tid, PMF_NO_CACHE_MAINT,
+				      ts);
+
+	return ts;
+}
+
+/* Record 'delta' in the given EHF instrumentation slot if it is a new maximum */
+static void ehf_instr_update_max(unsigned int tid, unsigned long long delta)
+{
+	unsigned long long max;
+
+	PMF_GET_TIMESTAMP_BY_INDEX(ehf_instr_svc, tid, plat_my_core_pos(),
+				   PMF_NO_CACHE_MAINT, max);
+	if (delta > max) {
+		PMF_WRITE_TIMESTAMP(ehf_instr_svc, tid, PMF_NO_CACHE_MAINT,
+				    delta);
+	}
+}
+
+/* Return the time elapsed since the timestamp held in the given slot */
+static unsigned long long ehf_instr_elapsed(unsigned int tid)
+{
+	unsigned long long ts;
+
+	PMF_GET_TIMESTAMP_BY_INDEX(ehf_instr_svc, tid, plat_my_core_pos(),
+				   PMF_NO_CACHE_MAINT, ts);
+
+	return read_cntpct_el0() - ts;
+}
+#endif /* EHF_INSTRUMENTATION */
+
 /* Translate priority to the index in the priority array */
 static unsigned int pri_to_idx(unsigned int priority)
 {
@@ -131,6 +174,10 @@ void ehf_activate_priority(unsigned int priority)
 	/* Set the bit corresponding to the requested priority */
 	pe_data->active_pri_bits |= PRI_BIT(idx);
 
+#if EHF_INSTRUMENTATION
+	(void) ehf_instr_capture(EHF_INSTR_PRI_ID(idx, EHF_INSTR_PRI_ACTIVATE));
+#endif
+
 	/*
 	 * Program priority mask for the activated level. Check that the new
 	 * priority mask is setting a higher priority level than the existing
@@ -198,6 +245,11 @@ void ehf_deactivate_priority(unsigned int priority)
 	/* Clear bit corresponding to highest priority */
 	pe_data->active_pri_bits &= (pe_data->active_pri_bits - 1u);
 
+#if EHF_INSTRUMENTATION
+	ehf_instr_update_max(EHF_INSTR_PRI_ID(idx, EHF_INSTR_PRI_MAX_ACTIVE),
+		ehf_instr_elapsed(EHF_INSTR_PRI_ID(idx, EHF_INSTR_PRI_ACTIVATE)));
+#endif
+
 	/*
 	 * Restore priority mask corresponding to the next priority, or the
 	 * one stashed earlier if there are no more to deactivate.
@@ -247,6 +299,10 @@ static void *ehf_exited_normal_world(const void *arg)
 	pe_data->ns_pri_mask =
 		(uint8_t) plat_ic_set_priority_mask(GIC_HIGHEST_NS_PRIORITY);
 
+#if EHF_INSTRUMENTATION
+	(void) ehf_instr_capture(EHF_INSTR_NS_MASK_START);
+#endif
+
 	/* The previous Priority Mask is not expected to be in secure range */
 	if (IS_PRI_SECURE(pe_data->ns_pri_mask)) {
 		ERROR("Priority Mask (0x%x) already in secure range\n",
@@ -309,6 +365,11 @@ static void *ehf_entering_normal_world(const void *arg)
 
 	pe_data->ns_pri_mask = 0;
 
+#if EHF_INSTRUMENTATION
+	ehf_instr_update_max(EHF_INSTR_MAX_NS_MASKED,
+			     ehf_instr_elapsed(EHF_INSTR_NS_MASK_START));
+#endif
+
 	return NULL;
 }
 
@@ -356,6 +417,11 @@ void ehf_allow_ns_preemption(uint64_t preempt_ret_code)
 	EHF_LOG("Priority Mask: 0x%x => 0x%x\n", old_pmr, pe_data->ns_pri_mask);
 
 	pe_data->ns_pri_mask = 0;
+
+#if EHF_INSTRUMENTATION
+	ehf_instr_update_max(EHF_INSTR_MAX_NS_MASKED,
+			     ehf_instr_elapsed(EHF_INSTR_NS_MASK_START));
+#endif
 }
 
 /*
@@ -397,6 +463,11 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	uint32_t intr_raw;
 	unsigned int intr, pri, idx;
 	ehf_handler_t handler;
+#if EHF_INSTRUMENTATION
+	unsigned long long entry_ts, ack_ts, exit_ts;
+
+	entry_ts = ehf_instr_capture(EHF_INSTR_INTR_ENTRY);
+#endif
 
 	/*
 	 * Top-level interrupt type handler from Interrupt Management Framework
@@ -417,6 +488,10 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	if (intr == INTR_ID_UNAVAILABLE)
 		return 0;
 
+#if EHF_INSTRUMENTATION
+	ack_ts = ehf_instr_capture(EHF_INSTR_INTR_ACK);
+#endif
+
 	/* Having acknowledged the interrupt, get the running priority */
 	pri = plat_ic_get_running_priority();
 
@@ -446,6 +521,14 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	 */
 	ret = handler(intr_raw, flags, handle, cookie);
 
+#if EHF_INSTRUMENTATION
+	exit_ts = ehf_instr_capture(EHF_INSTR_INTR_EXIT);
+	ehf_instr_update_max(EHF_INSTR_PRI_ID(idx, EHF_INSTR_PRI_MAX_ACK),
+			     ack_ts - entry_ts);
+	ehf_instr_update_max(EHF_INSTR_PRI_ID(idx, EHF_INSTR_PRI_MAX_HANDLER),
+			     exit_ts - ack_ts);
+#endif
+
 	return (uint64_t) ret;
 }
 
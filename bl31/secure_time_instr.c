@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arch_helpers.h>
+#include <bl31/secure_time_instr.h>
+#include <lib/el3_runtime/pubsub_events.h>
+#include <lib/pmf/pmf.h>
+#include <plat/common/platform.h>
+
+PMF_REGISTER_SERVICE_SMC(secure_time_instr_svc, PMF_SECURE_TIME_INSTR_SVC_ID,
+	SECURE_TIME_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+
+static unsigned long long secure_time_instr_get(unsigned int tid)
+{
+	unsigned long long val;
+
+	PMF_GET_TIMESTAMP_BY_INDEX(secure_time_instr_svc, tid,
+				   plat_my_core_pos(), PMF_NO_CACHE_MAINT, val);
+
+	return val;
+}
+
+static void *secure_time_instr_entry(const void *arg __unused)
+{
+	/* A nested entry, e.g. between Secure partitions, is not counted */
+	if (secure_time_instr_get(SECURE_TIME_INSTR_ENTRY) != 0ULL) {
+		return (void *)0;
+	}
+
+	PMF_CAPTURE_TIMESTAMP(secure_time_instr_svc, SECURE_TIME_INSTR_ENTRY,
+			      PMF_NO_CACHE_MAINT);
+
+	return (void *)0;
+}
+
+static void *secure_time_instr_exit(const void *arg __unused)
+{
+	unsigned long long entry, val;
+
+	entry = secure_time_instr_get(SECURE_TIME_INSTR_ENTRY);
+	if (entry == 0ULL) {
+		return (void *)0;
+	}
+
+	val = secure_time_instr_get(SECURE_TIME_INSTR_TOTAL) +
+	      (read_cntpct_el0() - entry);
+	PMF_WRITE_TIMESTAMP(secure_time_instr_svc, SECURE_TIME_INSTR_TOTAL,
+			    PMF_NO_CACHE_MAINT, val);
+
+	val = secure_time_instr_get(SECURE_TIME_INSTR_COUNT) + 1ULL;
+	PMF_WRITE_TIMESTAMP(secure_time_instr_svc, SECURE_TIME_INSTR_COUNT,
+			    PMF_NO_CACHE_MAINT, val);
+
+	val = 0ULL;
+	PMF_WRITE_TIMESTAMP(secure_time_instr_svc, SECURE_TIME_INSTR_ENTRY,
+			    PMF_NO_CACHE_MAINT, val);
+
+	return (void *)0;
+}
+
+SUBSCRIBE_TO_EVENT(cm_entering_secure_world, secure_time_instr_entry);
+SUBSCRIBE_TO_EVENT(cm_entering_normal_world, secure_time_instr_exit);
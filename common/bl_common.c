@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/io/io_storage.h>
+#include <lib/boot_timeline/boot_timeline.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
@@ -76,6 +77,10 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	size_t image_size;
 	size_t bytes_read;
 	int io_result;
+	unsigned int tl_load, tl_copy;
+#if LOAD_IMAGE_IN_PLACE
+	uintptr_t src;
+#endif
 
 	assert(image_data != NULL);
 	assert(image_data->h.version >= VERSION_2);
@@ -90,11 +95,14 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 		return io_result;
 	}
 
+	tl_load = boot_timeline_begin(BOOT_TL_PHASE_LOAD, image_id);
+
 	/* Attempt to access the image */
 	io_result = io_open(dev_handle, image_spec, &image_handle);
 	if (io_result != 0) {
 		WARN("Failed to access image id=%u (%i)\n",
 			image_id, io_result);
+		boot_timeline_end(tl_load);
 		return io_result;
 	}
 
@@ -121,9 +129,25 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	 */
 	image_data->image_size = (uint32_t)image_size;
 
+#if LOAD_IMAGE_IN_PLACE
+	/*
+	 * Avoid copying an image whose memory-mapped source is its load
+	 * address. Any other image, including the parent images which are
+	 * parsed again after their signature has been checked, is copied to
+	 * its load address so that it cannot change once it has been read.
+	 */
+	if ((io_map(image_handle, image_size, &src) == 0) &&
+	    (src == image_base)) {
+		INFO("Image id=%u already at 0x%lx\n", image_id, src);
+		goto exit;
+	}
+#endif /* LOAD_IMAGE_IN_PLACE */
+
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+	tl_copy = boot_timeline_begin(BOOT_TL_PHASE_COPY, image_id);
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	boot_timeline_end(tl_copy);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -140,6 +164,8 @@ exit:
 	(void)io_dev_close(dev_handle);
 	/* Ignore improbable/unrecoverable error in 'dev_close' */
 
+	boot_timeline_end(tl_load);
+
 	return io_result;
 }
 
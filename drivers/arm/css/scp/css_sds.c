@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -66,6 +66,12 @@ int css_scp_boot_ready(void)
 
 	VERBOSE("Waiting for SCP RAM to complete its initialization process\n");
 
+	/*
+	 * The SCP RAM Firmware publishes its own structures in the SDS memory
+	 * region, the structure headers indexed so far may be stale.
+	 */
+	sds_invalidate_index();
+
 	/* Wait for the SCP RAM Firmware to complete its initialization process */
 	while (retry > 0) {
 		ret = sds_struct_read(SDS_FEATURE_AVAIL_STRUCT_ID, 0,
@@ -81,8 +87,16 @@ int css_scp_boot_ready(void)
 		}
 
 		if (scp_feature_availability_flags &
-				SDS_FEATURE_AVAIL_SCP_RAM_READY_BIT)
+				SDS_FEATURE_AVAIL_SCP_RAM_READY_BIT) {
+			/*
+			 * The index was rebuilt by the reads above, possibly
+			 * while the SCP RAM Firmware was still laying out the
+			 * SDS memory region. Drop it now that the layout is
+			 * final.
+			 */
+			sds_invalidate_index();
 			return 0;
+		}
 
 		udelay(10);
 		retry--;
@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -26,6 +27,22 @@ static uintptr_t sds_mem_base;
 /* Size of the SDS memory region in bytes */
 static size_t sds_mem_size;
 
+/*
+ * Index of the structure headers, built once from the SDS memory region so
+ * that structures can be looked up without walking the region. Entry N holds
+ * the offset from sds_mem_base of the header of the structure with ID N, or 0
+ * if there is no such structure. Structures with larger IDs are looked up by
+ * walking the region.
+ */
+#ifdef PLAT_ARM_SDS_INDEX_SIZE
+#define SDS_INDEX_SIZE		PLAT_ARM_SDS_INDEX_SIZE
+#else
+#define SDS_INDEX_SIZE		32U
+#endif
+
+static uint32_t sds_index[SDS_INDEX_SIZE];
+static bool sds_index_valid;
+
 /*
  * Perform some non-exhaustive tests to determine whether any of the fields
  * within a Structure Header contain obviously invalid data.
@@ -81,16 +98,14 @@ static int validate_sds_struct_headers(void)
 }
 
 /*
- * Get the structure header pointer corresponding to the structure ID.
+ * Walk the structure headers to find the one with a matching ID.
  * Returns SDS_OK on success, SDS_ERR_STRUCT_NOT_FOUND on error.
  */
-static int get_struct_header(uint32_t structure_id, struct_header_t **header)
+static int find_struct_header(uint32_t structure_id, struct_header_t **header)
 {
 	unsigned int i, structure_count;
 	uintptr_t current_header;
 
-	assert(header);
-
 	structure_count = GET_SDS_REGION_STRUCTURE_COUNT(sds_mem_base);
 	if (structure_count == 0)
 		return SDS_ERR_STRUCT_NOT_FOUND;
@@ -111,6 +126,75 @@ static int get_struct_header(uint32_t structure_id, struct_header_t **header)
 	return SDS_ERR_STRUCT_NOT_FOUND;
 }
 
+/*
+ * Build the index of the structure headers with a single walk of the SDS
+ * memory region.
+ */
+static void build_sds_index(void)
+{
+	unsigned int i, structure_count;
+	uintptr_t current_header;
+	uint32_t id;
+
+	(void)memset(sds_index, 0, sizeof(sds_index));
+
+	structure_count = GET_SDS_REGION_STRUCTURE_COUNT(sds_mem_base);
+	current_header = ((uintptr_t)sds_mem_base) + SDS_REGION_DESC_SIZE;
+
+	for (i = 0; i < structure_count; i++) {
+		id = GET_SDS_HEADER_ID(current_header);
+
+		/* Keep the first header found, as the walk does */
+		if ((id < SDS_INDEX_SIZE) && (sds_index[id] == 0U))
+			sds_index[id] = current_header - sds_mem_base;
+
+		current_header += GET_SDS_HEADER_STRUCT_SIZE(current_header) +
+						SDS_HEADER_SIZE;
+	}
+
+	sds_index_valid = true;
+}
+
+/*
+ * Get the structure header pointer corresponding to the structure ID.
+ * Returns SDS_OK on success, SDS_ERR_STRUCT_NOT_FOUND on error.
+ */
+static int get_struct_header(uint32_t structure_id, struct_header_t **header)
+{
+	assert(header);
+
+	if (structure_id >= SDS_INDEX_SIZE)
+		return find_struct_header(structure_id, header);
+
+	if (!sds_index_valid)
+		build_sds_index();
+
+	/*
+	 * The structure may have been published by the SCP after the index
+	 * was built, fall back to walking the region and record it if found.
+	 */
+	if (sds_index[structure_id] == 0U) {
+		if (find_struct_header(structure_id, header) != SDS_OK)
+			return SDS_ERR_STRUCT_NOT_FOUND;
+
+		sds_index[structure_id] = (uintptr_t)*header - sds_mem_base;
+		return SDS_OK;
+	}
+
+	*header = (struct_header_t *)(sds_mem_base + sds_index[structure_id]);
+	return SDS_OK;
+}
+
+/*
+ * Discard the index of the structure headers. Must be called when the SCP
+ * may have laid out the SDS memory region again, for instance after it has
+ * booted a new firmware image. The index is then rebuilt on the next access.
+ */
+void sds_invalidate_index(void)
+{
+	sds_index_valid = false;
+}
+
 /*
  * Check if a structure header corresponding to the structure ID exists.
  * Returns SDS_OK if structure header exists else SDS_ERR_STRUCT_NOT_FOUND
@@ -255,5 +339,7 @@ int sds_init(void)
 	if (validate_sds_struct_headers() != SDS_OK)
 		return SDS_ERR_FAIL;
 
+	build_sds_index();
+
 	return SDS_OK;
 }
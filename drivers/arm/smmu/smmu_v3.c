@@ -1,31 +1,77 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
+
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <cdefs.h>
 #include <drivers/arm/smmu_v3.h>
 #include <drivers/delay_timer.h>
+#include <drivers/mmio_poll.h>
 #include <lib/mmio.h>
+#include <lib/spinlock.h>
+#include <lib/utils.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
 
 /* SMMU poll number of retries */
 #define SMMU_POLL_TIMEOUT_US	U(1000)
 
-static int __init smmuv3_poll(uintptr_t smmu_reg, uint32_t mask,
+/* Stream table entry fields */
+#define STE0_V				(1ULL << 0)
+#define STE0_CONFIG_ABORT		(0ULL << 1)
+#define STE0_CONFIG_BYPASS		(4ULL << 1)
+#define STE0_CONFIG_S1_TRANS		(5ULL << 1)
+#define STE0_S1CTXPTR_MASK		ULL(0x000fffffffffffc0)
+#define STE1_S1CIR_WB			(1ULL << 2)
+#define STE1_S1COR_WB			(1ULL << 4)
+#define STE1_S1CSH_IS			(3ULL << 6)
+#define STE1_SHCFG_INCOMING		(1ULL << 44)
+
+/* Context descriptor fields */
+#define CD0_T0SZ_MASK			ULL(0x3f)
+#define CD0_TG0_SHIFT			U(6)
+#define CD0_IRGN0_ORGN0_SH0_MASK	ULL(0x3f00)
+#define CD0_EPD1			(1ULL << 30)
+#define CD0_V				(1ULL << 31)
+#define CD0_IPS_SHIFT			U(32)
+#define CD0_AA64			(1ULL << 41)
+#define CD0_R				(1ULL << 45)
+#define CD0_A				(1ULL << 46)
+#define CD0_ASET			(1ULL << 47)
+#define CD0_ASID_SHIFT			U(48)
+#define CD1_TTB0_MASK			ULL(0x000ffffffffffff0)
+
+/* Mask of the TCR_EL1.IPS and TCR_EL3.PS fields */
+#define TCR_PS_MASK			ULL(0x7)
+
+/* Command fields */
+#define CMD_OP_CFGI_STE			ULL(0x03)
+#define CMD_OP_CFGI_ALL			ULL(0x04)
+#define CMD_OP_CFGI_CD			ULL(0x05)
+#define CMD_OP_TLBI_NH_ASID		ULL(0x11)
+#define CMD_OP_SYNC			ULL(0x46)
+#define CMD0_SSEC			(1ULL << 10)
+#define CMD0_SID_SHIFT			U(32)
+#define CMD0_ASID_SHIFT			U(48)
+#define CMD1_LEAF			(1ULL << 0)
+#define CMD1_RANGE_ALL			ULL(31)
+
+/* Serialises the use of the Secure command queues */
+static spinlock_t smmuv3_s_lock;
+
+static int smmuv3_poll(uintptr_t smmu_reg, uint32_t mask,
 				uint32_t value)
 {
 	uint32_t reg_val;
-	uint64_t timeout;
 
-	/* Set 1ms timeout value */
-	timeout = timeout_init_us(SMMU_POLL_TIMEOUT_US);
-	do {
-		reg_val = mmio_read_32(smmu_reg);
-		if ((reg_val & mask) == value)
-			return 0;
-	} while (!timeout_elapsed(timeout));
+	if (mmio_poll_timeout_32_val(smmu_reg, mask, value,
+				     SMMU_POLL_TIMEOUT_US, &reg_val) == 0) {
+		return 0;
+	}
 
 	ERROR("Timeout polling SMMUv3 register @%p\n", (void *)smmu_reg);
 	ERROR("Read value 0x%x, expected 0x%x\n", reg_val,
@@ -94,3 +140,332 @@ int __init smmuv3_init(uintptr_t smmu_base)
 	return smmuv3_poll(smmu_base + SMMU_S_INIT,
 				SMMU_S_INIT_INV_ALL, 0U);
 }
+
+/*
+ * Clean a range of the stream table or command queue to the point of
+ * coherency, in case the SMMU table walks are not coherent with the PE caches.
+ */
+static void smmuv3_s_clean(uintptr_t addr, size_t size)
+{
+	clean_dcache_range(addr, size);
+}
+
+/*
+ * Write a batch of commands followed by a CMD_SYNC in the Secure command
+ * queue, then wait for the SMMU to consume them. Must be called with
+ * smmuv3_s_lock held.
+ */
+static int smmuv3_s_cmdq_write(const smmuv3_s_config_t *config,
+			       const smmuv3_cmd_t *cmds, unsigned int num)
+{
+	uintptr_t base = config->smmu_base;
+	uint32_t qsize = 1U << config->cmdq_log2size;
+	uint32_t ptr_mask = (qsize << 1) - 1U;
+	uint32_t prod, cons, err, i;
+	smmuv3_cmd_t *entry;
+	uint64_t timeout;
+
+	assert((num + 1U) <= qsize);
+
+	prod = mmio_read_32(base + SMMU_S_CMDQ_PROD) & ptr_mask;
+
+	/* Wait for enough free entries for the batch and the CMD_SYNC */
+	timeout = timeout_init_us(SMMU_POLL_TIMEOUT_US);
+	do {
+		cons = mmio_read_32(base + SMMU_S_CMDQ_CONS) & ptr_mask;
+		if ((qsize - ((prod - cons) & ptr_mask)) > num) {
+			break;
+		}
+
+		if (timeout_elapsed(timeout)) {
+			ERROR("SMMUv3 Secure command queue full\n");
+			return -1;
+		}
+	} while (true);
+
+	for (i = 0U; i <= num; i++) {
+		entry = (smmuv3_cmd_t *)(config->cmdq_base +
+			((prod & (qsize - 1U)) * SMMU_CMD_SIZE));
+
+		if (i < num) {
+			*entry = cmds[i];
+		} else {
+			entry->dw[0] = CMD_OP_SYNC;
+			entry->dw[1] = 0ULL;
+		}
+
+		smmuv3_s_clean((uintptr_t)entry, SMMU_CMD_SIZE);
+		prod = (prod + 1U) & ptr_mask;
+	}
+
+	/* Make the commands visible to the SMMU before publishing them */
+	dsbsy();
+	mmio_write_32(base + SMMU_S_CMDQ_PROD, prod);
+
+	/* The CMD_SYNC completes once all the previous commands have */
+	timeout = timeout_init_us(SMMU_POLL_TIMEOUT_US);
+	do {
+		cons = mmio_read_32(base + SMMU_S_CMDQ_CONS);
+
+		err = (cons >> SMMU_S_CMDQ_CONS_ERR_SHIFT) &
+			SMMU_S_CMDQ_CONS_ERR_MASK;
+		if (err != 0U) {
+			ERROR("SMMUv3 Secure command queue error 0x%x\n", err);
+			return -1;
+		}
+
+		if ((cons & ptr_mask) == prod) {
+			return 0;
+		}
+	} while (!timeout_elapsed(timeout));
+
+	ERROR("Timeout waiting for SMMUv3 Secure command queue\n");
+	return -1;
+}
+
+/*
+ * Submit a batch of up to SMMU_CMDQ_MAX_BATCH commands to the Secure command
+ * queue. A single CMD_SYNC is issued after the batch, and the function only
+ * returns once the SMMU has completed all the commands.
+ */
+int smmuv3_s_cmdq_submit(const smmuv3_s_config_t *config,
+			 const smmuv3_cmd_t *cmds, unsigned int num)
+{
+	int ret;
+
+	assert(config != NULL);
+	assert(num <= SMMU_CMDQ_MAX_BATCH);
+
+	spin_lock(&smmuv3_s_lock);
+	ret = smmuv3_s_cmdq_write(config, cmds, num);
+	spin_unlock(&smmuv3_s_lock);
+
+	return ret;
+}
+
+/*
+ * Write a Secure stream table entry and invalidate the SMMU copies of it,
+ * along with any other command in 'cmds'. A valid entry is first made invalid
+ * so that the SMMU never observes a partially updated entry.
+ */
+static int smmuv3_s_write_ste(const smmuv3_s_config_t *config, uint32_t sid,
+			      const uint64_t ste[SMMU_STE_SIZE / 8U],
+			      smmuv3_cmd_t *cmds, unsigned int num)
+{
+	uint64_t *entry;
+	unsigned int i;
+	int ret;
+
+	assert(config != NULL);
+	assert(num < SMMU_CMDQ_MAX_BATCH);
+
+	if (sid >= (1U << config->strtab_log2size)) {
+		ERROR("Invalid SMMUv3 Secure stream ID %u\n", sid);
+		return -1;
+	}
+
+	entry = (uint64_t *)(config->strtab_base + (sid * SMMU_STE_SIZE));
+
+	cmds[num].dw[0] = CMD_OP_CFGI_STE | CMD0_SSEC |
+			  ((uint64_t)sid << CMD0_SID_SHIFT);
+	cmds[num].dw[1] = CMD1_LEAF;
+
+	spin_lock(&smmuv3_s_lock);
+
+	if ((entry[0] & STE0_V) != 0ULL) {
+		entry[0] = 0ULL;
+		smmuv3_s_clean((uintptr_t)entry, SMMU_STE_SIZE);
+
+		ret = smmuv3_s_cmdq_write(config, &cmds[num], 1U);
+		if (ret != 0) {
+			goto unlock;
+		}
+	}
+
+	for (i = 1U; i < (SMMU_STE_SIZE / 8U); i++) {
+		entry[i] = ste[i];
+	}
+	smmuv3_s_clean((uintptr_t)entry, SMMU_STE_SIZE);
+	dsbsy();
+
+	/* Publish the entry once the rest of it is visible to the SMMU */
+	entry[0] = ste[0];
+	smmuv3_s_clean((uintptr_t)entry, SMMU_STE_SIZE);
+
+	ret = smmuv3_s_cmdq_write(config, cmds, num + 1U);
+
+unlock:
+	spin_unlock(&smmuv3_s_lock);
+
+	return ret;
+}
+
+/*
+ * Set up the Secure stream table and command queue, and enable Secure
+ * translation. Every Secure stream aborts until its stream table entry has
+ * been written. Must be called after smmuv3_init().
+ */
+int smmuv3_s_setup(const smmuv3_s_config_t *config)
+{
+	uintptr_t base = config->smmu_base;
+	size_t strtab_size = (size_t)SMMU_STE_SIZE << config->strtab_log2size;
+	size_t cmdq_size = (size_t)SMMU_CMD_SIZE << config->cmdq_log2size;
+	uint32_t idr1 = mmio_read_32(base + SMMU_S_IDR1);
+	smmuv3_cmd_t cmd;
+
+	if ((idr1 & SMMU_S_IDR1_SECURE_IMPL) == 0U) {
+		ERROR("SMMUv3 doesn't support Secure state\n");
+		return -1;
+	}
+
+	if ((config->strtab_log2size > (idr1 & SMMU_S_IDR1_S_SIDSIZE_MASK)) ||
+	    ((config->strtab_base & (strtab_size - 1U)) != 0U) ||
+	    (config->cmdq_log2size < 1U) ||
+	    ((config->cmdq_base & (cmdq_size - 1U)) != 0U)) {
+		ERROR("Invalid SMMUv3 Secure tables configuration\n");
+		return -1;
+	}
+
+	/* Stop Secure translation and command processing */
+	mmio_write_32(base + SMMU_S_CR0, 0U);
+	if (smmuv3_poll(base + SMMU_S_CR0ACK,
+			SMMU_S_CR0_SMMUEN | SMMU_S_CR0_CMDQEN, 0U) != 0) {
+		return -1;
+	}
+
+	/* All stream table entries are initially invalid */
+	zeromem((void *)config->strtab_base, strtab_size);
+	smmuv3_s_clean(config->strtab_base, strtab_size);
+
+	mmio_write_32(base + SMMU_S_CR1,
+		      SMMU_S_CR1_QUEUE_IC_WB | SMMU_S_CR1_QUEUE_OC_WB |
+		      SMMU_S_CR1_QUEUE_SH_IS | SMMU_S_CR1_TABLE_IC_WB |
+		      SMMU_S_CR1_TABLE_OC_WB | SMMU_S_CR1_TABLE_SH_IS);
+	mmio_write_32(base + SMMU_S_CR2,
+		      SMMU_S_CR2_RECINVSID | SMMU_S_CR2_PTM);
+
+	/* Linear stream table */
+	mmio_write_64(base + SMMU_S_STRTAB_BASE, SMMU_S_BASE_RA |
+		      (config->strtab_base & SMMU_S_STRTAB_BASE_ADDR_MASK));
+	mmio_write_32(base + SMMU_S_STRTAB_BASE_CFG, config->strtab_log2size);
+
+	mmio_write_64(base + SMMU_S_CMDQ_BASE, SMMU_S_BASE_RA |
+		      (config->cmdq_base & SMMU_S_CMDQ_BASE_ADDR_MASK) |
+		      config->cmdq_log2size);
+	mmio_write_32(base + SMMU_S_CMDQ_PROD, 0U);
+	mmio_write_32(base + SMMU_S_CMDQ_CONS, 0U);
+
+	mmio_write_32(base + SMMU_S_CR0, SMMU_S_CR0_CMDQEN);
+	if (smmuv3_poll(base + SMMU_S_CR0ACK, SMMU_S_CR0_CMDQEN,
+			SMMU_S_CR0_CMDQEN) != 0) {
+		return -1;
+	}
+
+	/* Discard any configuration cached before the tables were set up */
+	cmd.dw[0] = CMD_OP_CFGI_ALL | CMD0_SSEC;
+	cmd.dw[1] = CMD1_RANGE_ALL;
+	if (smmuv3_s_cmdq_submit(config, &cmd, 1U) != 0) {
+		return -1;
+	}
+
+	mmio_write_32(base + SMMU_S_CR0,
+		      SMMU_S_CR0_CMDQEN | SMMU_S_CR0_SMMUEN);
+
+	return smmuv3_poll(base + SMMU_S_CR0ACK,
+			   SMMU_S_CR0_CMDQEN | SMMU_S_CR0_SMMUEN,
+			   SMMU_S_CR0_CMDQEN | SMMU_S_CR0_SMMUEN);
+}
+
+/* Abort all transactions of a Secure stream */
+int smmuv3_s_ste_abort(const smmuv3_s_config_t *config, uint32_t sid)
+{
+	uint64_t ste[SMMU_STE_SIZE / 8U] = { STE0_V | STE0_CONFIG_ABORT };
+	smmuv3_cmd_t cmds[1];
+
+	return smmuv3_s_write_ste(config, sid, ste, cmds, 0U);
+}
+
+/* Let the transactions of a Secure stream bypass translation */
+int smmuv3_s_ste_bypass(const smmuv3_s_config_t *config, uint32_t sid)
+{
+	uint64_t ste[SMMU_STE_SIZE / 8U] = { STE0_V | STE0_CONFIG_BYPASS };
+	smmuv3_cmd_t cmds[1];
+
+	ste[1] = STE1_SHCFG_INCOMING;
+
+	return smmuv3_s_write_ste(config, sid, ste, cmds, 0U);
+}
+
+/*
+ * Translate the transactions of a Secure stream with the translation tables
+ * of an xlat library context, so that a DMA master sees the same memory map
+ * as the context. The SMMU walks the tables as a stage 1 translation, using
+ * the context descriptor at 'cd_base' (SMMU_CD_SIZE bytes, aligned to its
+ * size), tagged with 'asid'. The context must have been initialised and
+ * must use 4KB granule tables.
+ */
+int smmuv3_s_ste_xlat(const smmuv3_s_config_t *config, uint32_t sid,
+		      uintptr_t cd_base, uint16_t asid,
+		      const xlat_ctx_t *ctx)
+{
+	uint64_t mmu_cfg[MMU_CFG_PARAM_MAX];
+	uint64_t ste[SMMU_STE_SIZE / 8U] = { 0ULL };
+	uint64_t *cd = (uint64_t *)cd_base;
+	uint64_t tcr, ps;
+	smmuv3_cmd_t cmds[3];
+
+	assert(ctx != NULL);
+	assert(ctx->initialized);
+	assert((cd_base & (SMMU_CD_SIZE - 1U)) == 0U);
+
+	setup_mmu_cfg(mmu_cfg, 0U, ctx->base_table, ctx->pa_max_address,
+		      ctx->va_max_address, ctx->xlat_regime);
+
+	tcr = mmu_cfg[MMU_CFG_TCR];
+	if (ctx->xlat_regime == EL1_EL0_REGIME) {
+		ps = (tcr >> TCR_EL1_IPS_SHIFT) & TCR_PS_MASK;
+	} else {
+		ps = (tcr >> TCR_EL3_PS_SHIFT) & TCR_PS_MASK;
+	}
+
+	/* Context descriptor, only TTB0 is used */
+	zeromem(cd, SMMU_CD_SIZE);
+	cd[1] = mmu_cfg[MMU_CFG_TTBR0] & CD1_TTB0_MASK;
+	cd[3] = mmu_cfg[MMU_CFG_MAIR];
+	cd[0] = (tcr & CD0_T0SZ_MASK) |
+		(((tcr >> TCR_TG0_SHIFT) & TCR_TG0_MASK) << CD0_TG0_SHIFT) |
+		(tcr & CD0_IRGN0_ORGN0_SH0_MASK) |
+		(ps << CD0_IPS_SHIFT) |
+		CD0_EPD1 | CD0_AA64 | CD0_R | CD0_A | CD0_ASET |
+		((uint64_t)asid << CD0_ASID_SHIFT) | CD0_V;
+	smmuv3_s_clean(cd_base, SMMU_CD_SIZE);
+
+	ste[0] = STE0_V | STE0_CONFIG_S1_TRANS |
+		 (cd_base & STE0_S1CTXPTR_MASK);
+	ste[1] = STE1_S1CIR_WB | STE1_S1COR_WB | STE1_S1CSH_IS |
+		 STE1_SHCFG_INCOMING;
+
+	/* Discard cached copies of the context descriptor and translations */
+	cmds[0].dw[0] = CMD_OP_CFGI_CD | CMD0_SSEC |
+			((uint64_t)sid << CMD0_SID_SHIFT);
+	cmds[0].dw[1] = CMD1_LEAF;
+	cmds[1].dw[0] = CMD_OP_TLBI_NH_ASID |
+			((uint64_t)asid << CMD0_ASID_SHIFT);
+	cmds[1].dw[1] = 0ULL;
+
+	return smmuv3_s_write_ste(config, sid, ste, cmds, 2U);
+}
+
+/*
+ * Invalidate the SMMU TLB entries of an ASID used by smmuv3_s_ste_xlat(),
+ * e.g. after the memory map of the xlat context has been changed.
+ */
+int smmuv3_s_tlbi_asid(const smmuv3_s_config_t *config, uint16_t asid)
+{
+	smmuv3_cmd_t cmd;
+
+	cmd.dw[0] = CMD_OP_TLBI_NH_ASID | ((uint64_t)asid << CMD0_ASID_SHIFT);
+	cmd.dw[1] = 0ULL;
+
+	return smmuv3_s_cmdq_submit(config, &cmd, 1U);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 
 #include <common/debug.h>
 #include <drivers/arm/tzc400.h>
+#include <drivers/arm/tzc_telemetry.h>
 #include <lib/mmio.h>
 #include <lib/utils_def.h>
 
@@ -35,6 +36,7 @@ typedef struct tzc400_instance {
 	uint8_t addr_width;
 	uint8_t num_filters;
 	uint8_t num_regions;
+	uint8_t action;
 } tzc400_instance_t;
 
 static tzc400_instance_t tzc400;
@@ -82,7 +84,7 @@ static uint32_t _tzc400_get_int_by_filter(uintptr_t base, uint32_t filter)
 	return mmio_read_32(base + INT_STATUS) & BIT_32(filter);
 }
 
-#if DEBUG
+#if DEBUG || TZC_TELEMETRY_ENABLED
 static unsigned long _tzc400_get_fail_address(uintptr_t base, uint32_t filter)
 {
 	unsigned long fail_address;
@@ -106,7 +108,9 @@ static uint32_t _tzc400_get_fail_control(uintptr_t base, uint32_t filter)
 {
 	return mmio_read_32(base + FAIL_CONTROL_OFF + (filter * FILTER_OFFSET));
 }
+#endif /* DEBUG || TZC_TELEMETRY_ENABLED */
 
+#if DEBUG
 static void _tzc400_dump_fail_filter(uintptr_t base, uint32_t filter)
 {
 	uint32_t control_fail;
@@ -143,6 +147,89 @@ static void _tzc400_dump_fail_filter(uintptr_t base, uint32_t filter)
 }
 #endif /* DEBUG */
 
+#if TZC_TELEMETRY_ENABLED
+/* Mask or unmask the interrupt raised on failed accesses */
+static void _tzc400_set_fail_int(bool enable)
+{
+	unsigned int action = tzc400.action;
+
+	if (!enable) {
+		action &= ~TZC_ACTION_INT;
+	}
+
+	_tzc400_write_action(tzc400.base, action);
+}
+
+static void _tzc400_record_fail_filter(uintptr_t base, uint32_t filter)
+{
+	tzc_fault_t fault = { 0 };
+	uint32_t control_fail;
+
+	fault.address = _tzc400_get_fail_address(base, filter);
+	fault.fail_id = _tzc400_get_fail_id(base, filter);
+	fault.filter = (uint8_t)filter;
+
+	control_fail = _tzc400_get_fail_control(base, filter);
+	if (((control_fail & BIT_32(FAIL_CONTROL_NS_SHIFT)) >> FAIL_CONTROL_NS_SHIFT) ==
+	    FAIL_CONTROL_NS_NONSECURE) {
+		fault.flags |= TZC_FAULT_NS;
+	}
+
+	if (((control_fail & BIT_32(FAIL_CONTROL_PRIV_SHIFT)) >> FAIL_CONTROL_PRIV_SHIFT) ==
+	    FAIL_CONTROL_PRIV_PRIV) {
+		fault.flags |= TZC_FAULT_PRIV;
+	}
+
+	if (((control_fail & BIT_32(FAIL_CONTROL_DIR_SHIFT)) >> FAIL_CONTROL_DIR_SHIFT) ==
+	    FAIL_CONTROL_DIR_WRITE) {
+		fault.flags |= TZC_FAULT_WRITE;
+	}
+
+	tzc_telemetry_record(&fault);
+}
+
+/*
+ * Load the current region configuration into the telemetry, so that failed
+ * accesses can be accounted per region even when the regions have been
+ * programmed by an earlier boot stage.
+ */
+static void _tzc400_telemetry_init(uintptr_t base)
+{
+	unsigned long long region_base, region_top;
+	unsigned int region, filters;
+	uintptr_t region_off;
+
+	tzc400.action = (uint8_t)(mmio_read_32(base + TZC_400_ACTION_OFF) &
+				  TZC_ACTION_RV_MASK);
+	tzc_telemetry_init(_tzc400_set_fail_int);
+
+	/* Region 0 covers the whole address space on all filters */
+	tzc_telemetry_set_region(0U, 0ULL, UINT64_MAX,
+				 (1U << tzc400.num_filters) - 1U);
+
+	for (region = 1U; region < tzc400.num_regions; region++) {
+		region_off = base + TZC_REGION_OFFSET(TZC_400_REGION_SIZE,
+						      region);
+
+		region_base = mmio_read_32(region_off +
+					   TZC_400_REGION_BASE_LOW_0_OFFSET);
+		region_base |= (unsigned long long)mmio_read_32(region_off +
+					TZC_400_REGION_BASE_HIGH_0_OFFSET) << 32;
+		region_top = mmio_read_32(region_off +
+					  TZC_400_REGION_TOP_LOW_0_OFFSET);
+		region_top |= (unsigned long long)mmio_read_32(region_off +
+					TZC_400_REGION_TOP_HIGH_0_OFFSET) << 32;
+		filters = (mmio_read_32(region_off +
+					TZC_400_REGION_ATTR_0_OFFSET) >>
+			   TZC_REGION_ATTR_F_EN_SHIFT) &
+			  ((1U << tzc400.num_filters) - 1U);
+
+		tzc_telemetry_set_region(region, region_base, region_top,
+					 filters);
+	}
+}
+#endif /* TZC_TELEMETRY_ENABLED */
+
 static unsigned int _tzc400_get_gate_keeper(uintptr_t base,
 				unsigned int filter)
 {
@@ -181,6 +268,7 @@ void tzc400_set_action(unsigned int action)
 	assert(tzc400.base != 0U);
 	assert(action <= TZC_ACTION_ERR_INT);
 
+	tzc400.action = (uint8_t)action;
 	_tzc400_write_action(tzc400.base, action);
 }
 
@@ -210,6 +298,10 @@ void tzc400_init(uintptr_t base)
 					BUILD_CONFIG_AW_MASK) + 1U;
 	tzc400.num_regions = (uint8_t)((tzc400_build >> BUILD_CONFIG_NR_SHIFT) &
 					BUILD_CONFIG_NR_MASK) + 1U;
+
+#if TZC_TELEMETRY_ENABLED
+	_tzc400_telemetry_init(tzc400.base);
+#endif
 }
 
 /*
@@ -270,6 +362,10 @@ void tzc400_configure_region(unsigned int filters,
 	_tzc400_configure_region(tzc400.base, filters, region, region_base,
 						region_top,
 						sec_attr, nsaid_permissions);
+
+#if TZC_TELEMETRY_ENABLED
+	tzc_telemetry_set_region(region, region_base, region_top, filters);
+#endif
 }
 
 void tzc400_update_filters(unsigned int region, unsigned int filters)
@@ -279,6 +375,13 @@ void tzc400_update_filters(unsigned int region, unsigned int filters)
 	       (region < tzc400.num_regions));
 
 	_tzc400_update_filters(tzc400.base, region, tzc400.num_filters, filters);
+
+#if TZC_TELEMETRY_ENABLED
+	/* Region 0 is always enabled on all filters */
+	if (region != 0U) {
+		tzc_telemetry_update_filters(region, filters);
+	}
+#endif
 }
 
 void tzc400_enable_filters(void)
@@ -354,6 +457,10 @@ int tzc400_it_handler(void)
 	_tzc400_dump_fail_filter(tzc400.base, filter_it_pending);
 #endif
 
+#if TZC_TELEMETRY_ENABLED
+	_tzc400_record_fail_filter(tzc400.base, filter_it_pending);
+#endif
+
 	_tzc400_clear_it(tzc400.base, filter_it_pending);
 
 	return 0;
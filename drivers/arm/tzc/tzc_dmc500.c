@@ -1,15 +1,18 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 
 #include <common/debug.h>
 #include <drivers/arm/tzc_dmc500.h>
 #include <drivers/arm/tzc_common.h>
+#include <drivers/arm/tzc_telemetry.h>
 #include <lib/mmio.h>
+#include <lib/utils.h>
 
 #include "tzc_common_private.h"
 
@@ -54,6 +57,15 @@ static tzc_dmc500_regions_t g_conf_regions[MAX_REGION_VAL + 1];
 #define DMC_INST_SI_BASE(instance, interface) \
 		(DMC_INST_BASE_ADDR(instance) + IFACE_OFFSET(interface))
 
+/*
+ * Each system interface of each DMC instance reports its own failed accesses,
+ * they are accounted as separate filters by the telemetry.
+ */
+#define DMC_SI_FILTER(instance, interface) \
+		(((unsigned int)(instance) * MAX_SYS_IF_COUNT) + \
+		 (unsigned int)(interface))
+#define DMC_ALL_FILTERS		((1U << (MAX_DMC_COUNT * MAX_SYS_IF_COUNT)) - 1U)
+
 DEFINE_TZC_COMMON_WRITE_ACTION(_dmc500, DMC500)
 DEFINE_TZC_COMMON_WRITE_REGION_BASE(_dmc500, DMC500)
 DEFINE_TZC_COMMON_WRITE_REGION_TOP(_dmc500, DMC500)
@@ -77,6 +89,26 @@ static inline void _tzc_dmc500_write_flush_control(uintptr_t dmc_si_base)
 	mmio_write_32(dmc_si_base + SI_FLUSH_CTRL_OFFSET, 1);
 }
 
+#if TZC_TELEMETRY_ENABLED
+/* Mask or unmask the failed access interrupt of all the system interfaces */
+static void _tzc_dmc500_set_fail_int(bool enable)
+{
+	int dmc_inst, sys_if;
+
+	for (dmc_inst = 0; dmc_inst < g_driver_data->dmc_count; dmc_inst++) {
+		for (sys_if = 0; sys_if < g_sys_if_count; sys_if++) {
+			mmio_clrsetbits_32(DMC_INST_SI_BASE(dmc_inst, sys_if) +
+					   SI_INT_CONTROL_OFFSET,
+					   FAILED_ACCESS_INT_EN <<
+					   FAILED_ACCESS_INT_EN_SHIFT,
+					   enable ? (FAILED_ACCESS_INT_EN <<
+						     FAILED_ACCESS_INT_EN_SHIFT) :
+					   0U);
+		}
+	}
+}
+#endif /* TZC_TELEMETRY_ENABLED */
+
 /*
  * Sets the Flush controls for all the DMC Instances and System Interfaces.
  * This initiates the flush of configuration settings from the shadow
@@ -165,6 +197,10 @@ void tzc_dmc500_configure_region0(unsigned int sec_attr,
 
 	g_conf_regions[0].sec_attr = sec_attr;
 	g_conf_regions[0].is_enabled = 1;
+
+#if TZC_TELEMETRY_ENABLED
+	tzc_telemetry_set_region(0U, 0ULL, UINT64_MAX, DMC_ALL_FILTERS);
+#endif
 }
 
 /*
@@ -208,6 +244,11 @@ void tzc_dmc500_configure_region(unsigned int region_no,
 
 	g_conf_regions[region_no].sec_attr = sec_attr;
 	g_conf_regions[region_no].is_enabled = 1;
+
+#if TZC_TELEMETRY_ENABLED
+	tzc_telemetry_set_region(region_no, region_base, region_top,
+				 DMC_ALL_FILTERS);
+#endif
 }
 
 /* Sets the action value for all the DMC instances */
@@ -220,14 +261,86 @@ void tzc_dmc500_set_action(unsigned int action)
 	for (dmc_inst = 0; dmc_inst < g_driver_data->dmc_count; dmc_inst++) {
 		assert(DMC_INST_BASE_ADDR(dmc_inst));
 		/*
-		 * - Currently no handler is provided to trap an error via
-		 *   interrupt or exception.
+		 * - Failed access interrupts can be handled through
+		 *   tzc_dmc500_it_handler(), no handler is provided to trap
+		 *   an error via exception.
 		 * - The interrupt action has not been tested.
 		 */
 		_tzc_dmc500_write_action(DMC_INST_BASE_ADDR(dmc_inst), action);
 	}
 }
 
+/*
+ * Handles the failed access interrupt of the DMC-500 instances. Every system
+ * interface with a pending failed access is reported and cleared. Returns 0
+ * if at least one failed access was handled and -1 otherwise.
+ */
+int tzc_dmc500_it_handler(void)
+{
+	int dmc_inst, sys_if;
+	int ret = -1;
+	uintptr_t si_base;
+	unsigned int status;
+	unsigned long long fail_address;
+#if TZC_TELEMETRY_ENABLED
+	tzc_fault_t fault;
+	unsigned int control;
+#endif
+
+	assert(g_driver_data);
+
+	for (dmc_inst = 0; dmc_inst < g_driver_data->dmc_count; dmc_inst++) {
+		for (sys_if = 0; sys_if < g_sys_if_count; sys_if++) {
+			si_base = DMC_INST_SI_BASE(dmc_inst, sys_if);
+
+			status = mmio_read_32(si_base + SI_INT_STATUS_OFFSET);
+			if (((status >> FAILED_ACCESS_INT_STATUS_SHIFT) &
+			     FAILED_ACCESS_INT_STATUS_MASK) == 0U)
+				continue;
+
+			fail_address = mmio_read_32(si_base +
+					SI_TZ_FAIL_ADDRESS_LOW_OFFSET);
+			fail_address |= (unsigned long long)mmio_read_32(
+					si_base + SI_TZ_FAIL_ADDRESS_HIGH_OFFSET)
+					<< 32;
+
+			VERBOSE("DMC-500 %d/%d: Illegal access to 0x%llx\n",
+				dmc_inst, sys_if, fail_address);
+
+#if TZC_TELEMETRY_ENABLED
+			zeromem(&fault, sizeof(fault));
+			fault.address = fail_address;
+			fault.fail_id = mmio_read_32(si_base +
+						     SI_FAIL_ID_OFFSET);
+			fault.filter = (uint8_t)DMC_SI_FILTER(dmc_inst, sys_if);
+
+			control = mmio_read_32(si_base +
+					       SI_FAIL_CONTROL_OFFSET);
+			if (((control >> NON_SECURE_SHIFT) &
+			     NON_SECURE_MASK) != 0U)
+				fault.flags |= TZC_FAULT_NS;
+			if (((control >> PRIVILEGED_SHIFT) &
+			     PRIVILEGED_MASK) != 0U)
+				fault.flags |= TZC_FAULT_PRIV;
+			if (((control >> DIRECTION_SHIFT) &
+			     DIRECTION_MASK) != 0U)
+				fault.flags |= TZC_FAULT_WRITE;
+
+			tzc_telemetry_record(&fault);
+#endif
+
+			mmio_write_32(si_base + SI_INT_CLR_OFFSET,
+				(FAILED_ACCESS_INT_CLR <<
+				 FAILED_ACCESS_INT_CLR_SHIFT) |
+				(FAILED_ACCESS_OFLOW_CLR <<
+				 FAILED_ACCESS_OFLOW_CLR_SHIFT));
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
 /*
  * A DMC-500 instance must be present at each base address provided by the
  * platform. It also expects platform to pass at least one instance of
@@ -284,4 +397,8 @@ void tzc_dmc500_driver_init(const tzc_dmc500_driver_data_t *plat_driver_data)
 	/* If interface count is not present then assume max */
 	if (g_sys_if_count == 0U)
 		g_sys_if_count = MAX_SYS_IF_COUNT;
+
+#if TZC_TELEMETRY_ENABLED
+	tzc_telemetry_init(_tzc_dmc500_set_fail_int);
+#endif
 }
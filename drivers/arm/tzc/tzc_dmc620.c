@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +8,7 @@
 
 #include <common/debug.h>
 #include <drivers/arm/tzc_dmc620.h>
+#include <drivers/arm/tzc_telemetry.h>
 #include <lib/mmio.h>
 
 /* Mask to extract bit 31 to 16 */
@@ -138,6 +139,38 @@ static void tzc_dmc620_verify_complete(void)
 	}
 }
 
+#if TZC_TELEMETRY_ENABLED
+/*
+ * Load the region configuration of the platform into the TZC telemetry, each
+ * DMC-620 instance being accounted as a separate filter. The failed access
+ * registers of the DMC-620 are not handled by this driver, so faults are only
+ * recorded when the platform error handler passes them to
+ * tzc_telemetry_record(), with the DMC instance as filter.
+ */
+void tzc_dmc620_telemetry_init(
+			const tzc_dmc620_config_data_t *plat_config_data)
+{
+	const tzc_dmc620_acc_addr_data_t *acc_addr;
+	unsigned int dmc_count, filters;
+	uint8_t i;
+
+	assert(plat_config_data != NULL);
+	assert(plat_config_data->acc_addr_count <= TZC_TELEMETRY_MAX_REGIONS);
+
+	dmc_count = plat_config_data->plat_drv_data->dmc_count;
+	assert(dmc_count <= TZC_TELEMETRY_MAX_FILTERS);
+	filters = (1U << dmc_count) - 1U;
+
+	tzc_telemetry_init(NULL);
+
+	for (i = 0U; i < plat_config_data->acc_addr_count; i++) {
+		acc_addr = &plat_config_data->plat_acc_addr_data[i];
+		tzc_telemetry_set_region(i, acc_addr->region_base,
+					 acc_addr->region_top, filters);
+	}
+}
+#endif /* TZC_TELEMETRY_ENABLED */
+
 /*
  * Initialize the DMC-620 TrustZone Controller using the region configuration
  * supplied by the platform. The DMC620 controller should be enabled elsewhere
@@ -173,5 +206,10 @@ void arm_tzc_dmc620_setup(const tzc_dmc620_config_data_t *plat_config_data)
 
 	tzc_dmc620_set_action();
 	tzc_dmc620_verify_complete();
+
+#if TZC_TELEMETRY_ENABLED
+	tzc_dmc620_telemetry_init(plat_config_data);
+#endif
+
 	INFO("DMC-620 TZC setup completed\n");
 }
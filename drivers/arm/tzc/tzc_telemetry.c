@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <drivers/arm/tzc_telemetry.h>
+#include <drivers/delay_timer.h>
+#include <lib/cassert.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+
+/* Number of recent faults kept in the ring, must be a power of two */
+#ifndef PLAT_TZC_TELEMETRY_RING_SIZE
+#define PLAT_TZC_TELEMETRY_RING_SIZE		U(16)
+#endif
+
+/*
+ * The failed access interrupt is masked when more than
+ * PLAT_TZC_TELEMETRY_RATE_LIMIT faults are reported within
+ * PLAT_TZC_TELEMETRY_RATE_WINDOW_US microseconds.
+ */
+#ifndef PLAT_TZC_TELEMETRY_RATE_LIMIT
+#define PLAT_TZC_TELEMETRY_RATE_LIMIT		U(64)
+#endif
+
+#ifndef PLAT_TZC_TELEMETRY_RATE_WINDOW_US
+#define PLAT_TZC_TELEMETRY_RATE_WINDOW_US	U(100000)
+#endif
+
+#define RING_SIZE	PLAT_TZC_TELEMETRY_RING_SIZE
+
+CASSERT(IS_POWER_OF_TWO(RING_SIZE), assert_tzc_telemetry_ring_size);
+
+typedef struct tzc_telemetry_region {
+	unsigned long long base;
+	unsigned long long top;
+	/* Bitmap of the filters the region is enabled on, 0 if unused */
+	unsigned int filters;
+} tzc_telemetry_region_t;
+
+/*
+ * Faults are only recorded by the interrupt handler of the controller, which
+ * is not reentrant, while the ring can be read from any CPU through the SMC
+ * interface. Each ring slot is protected by a sequence count that is odd while
+ * the slot is being written, so that readers can detect and retry a torn read
+ * without the interrupt handler having to take a lock.
+ */
+static struct {
+	tzc_fault_t ring[RING_SIZE];
+	volatile uint32_t seq[RING_SIZE];
+	volatile uint32_t head;
+
+	uint32_t filter_faults[TZC_TELEMETRY_MAX_FILTERS];
+	uint32_t region_faults[TZC_TELEMETRY_MAX_REGIONS];
+	uint32_t throttle_count;
+
+	uint64_t window_start;
+	uint32_t window_faults;
+	bool throttled;
+
+	tzc_telemetry_set_int_t set_int;
+	tzc_telemetry_region_t regions[TZC_TELEMETRY_MAX_REGIONS];
+} tzc_telemetry;
+
+/*
+ * Return the region which a failed access was checked against. As on the TZC,
+ * a higher numbered region takes priority over a lower numbered one.
+ */
+static unsigned int tzc_telemetry_find_region(uint64_t address,
+					      unsigned int filter)
+{
+	const tzc_telemetry_region_t *region;
+	unsigned int i = TZC_TELEMETRY_MAX_REGIONS;
+
+	while (i-- > 0U) {
+		region = &tzc_telemetry.regions[i];
+
+		if (((region->filters & BIT_32(filter)) != 0U) &&
+		    (address >= region->base) && (address <= region->top)) {
+			return i;
+		}
+	}
+
+	return TZC_TELEMETRY_NO_REGION;
+}
+
+/*
+ * Mask the failed access interrupt if the controller reports faults faster than
+ * the configured rate. It stays masked until tzc_telemetry_rearm() is called.
+ */
+static void tzc_telemetry_rate_limit(uint64_t now)
+{
+	if ((now - tzc_telemetry.window_start) >
+	    timeout_cnt_us2cnt(PLAT_TZC_TELEMETRY_RATE_WINDOW_US)) {
+		tzc_telemetry.window_start = now;
+		tzc_telemetry.window_faults = 0U;
+	}
+
+	tzc_telemetry.window_faults++;
+
+	if ((tzc_telemetry.window_faults <= PLAT_TZC_TELEMETRY_RATE_LIMIT) ||
+	    tzc_telemetry.throttled || (tzc_telemetry.set_int == NULL)) {
+		return;
+	}
+
+	WARN("TZC: Failed access storm, interrupt masked\n");
+
+	tzc_telemetry.throttled = true;
+	tzc_telemetry.throttle_count++;
+	tzc_telemetry.set_int(false);
+}
+
+/*
+ * Initialise the telemetry of the TZC controller. 'set_int' is used to mask
+ * the failed access interrupt when the rate limit is exceeded and may be NULL
+ * if the controller does not support it.
+ */
+void tzc_telemetry_init(tzc_telemetry_set_int_t set_int)
+{
+	zeromem(&tzc_telemetry, sizeof(tzc_telemetry));
+	tzc_telemetry.set_int = set_int;
+}
+
+/*
+ * Record the address range and filters of a region programmed into the
+ * controller, used to account failed accesses per region.
+ */
+void tzc_telemetry_set_region(unsigned int region,
+			      unsigned long long region_base,
+			      unsigned long long region_top,
+			      unsigned int filters)
+{
+	assert(region < TZC_TELEMETRY_MAX_REGIONS);
+
+	tzc_telemetry.regions[region].base = region_base;
+	tzc_telemetry.regions[region].top = region_top;
+	tzc_telemetry.regions[region].filters = filters;
+}
+
+/* Record a change of the filters a region is enabled on */
+void tzc_telemetry_update_filters(unsigned int region, unsigned int filters)
+{
+	assert(region < TZC_TELEMETRY_MAX_REGIONS);
+
+	tzc_telemetry.regions[region].filters = filters;
+}
+
+/*
+ * Record a failed access reported by the controller. The driver fills in the
+ * address, id, filter and flags of the fault, the timestamp and region are
+ * computed here. Must only be called from the controller interrupt handler.
+ */
+void tzc_telemetry_record(tzc_fault_t *fault)
+{
+	uint64_t now = read_cntpct_el0();
+	uint32_t head = tzc_telemetry.head;
+	uint32_t slot = head & (RING_SIZE - 1U);
+
+	fault->timestamp = now;
+	fault->region = (uint8_t)tzc_telemetry_find_region(fault->address,
+							   fault->filter);
+
+	if (fault->filter < TZC_TELEMETRY_MAX_FILTERS) {
+		tzc_telemetry.filter_faults[fault->filter]++;
+	}
+
+	if (fault->region < TZC_TELEMETRY_MAX_REGIONS) {
+		tzc_telemetry.region_faults[fault->region]++;
+	}
+
+	tzc_telemetry.seq[slot]++;
+	dmbish();
+	tzc_telemetry.ring[slot] = *fault;
+	dmbish();
+	tzc_telemetry.seq[slot]++;
+	tzc_telemetry.head = head + 1U;
+
+	tzc_telemetry_rate_limit(now);
+}
+
+/*
+ * Copy the index-th most recent fault, 0 being the latest one. Returns -1 if
+ * fewer faults are held in the ring.
+ */
+int tzc_telemetry_get_fault(unsigned int index, tzc_fault_t *fault)
+{
+	uint32_t head, seq, slot;
+
+	do {
+		head = tzc_telemetry.head;
+		if ((index >= RING_SIZE) || (index >= head)) {
+			return -1;
+		}
+
+		slot = (head - 1U - index) & (RING_SIZE - 1U);
+
+		seq = tzc_telemetry.seq[slot];
+		dmbish();
+		*fault = tzc_telemetry.ring[slot];
+		dmbish();
+	} while (((seq & 1U) != 0U) || (seq != tzc_telemetry.seq[slot]) ||
+		 (head != tzc_telemetry.head));
+
+	return 0;
+}
+
+uint32_t tzc_telemetry_filter_faults(unsigned int filter)
+{
+	assert(filter < TZC_TELEMETRY_MAX_FILTERS);
+
+	return tzc_telemetry.filter_faults[filter];
+}
+
+uint32_t tzc_telemetry_region_faults(unsigned int region)
+{
+	assert(region < TZC_TELEMETRY_MAX_REGIONS);
+
+	return tzc_telemetry.region_faults[region];
+}
+
+uint32_t tzc_telemetry_total_faults(void)
+{
+	return tzc_telemetry.head;
+}
+
+uint32_t tzc_telemetry_throttle_count(void)
+{
+	return tzc_telemetry.throttle_count;
+}
+
+/*
+ * Unmask the failed access interrupt after it has been rate limited. The
+ * recorded faults and counters are kept, so that the Normal world cannot erase
+ * the evidence of the accesses it made.
+ */
+void tzc_telemetry_rearm(void)
+{
+	tzc_telemetry.window_start = read_cntpct_el0();
+	tzc_telemetry.window_faults = 0U;
+
+	if (tzc_telemetry.throttled) {
+		tzc_telemetry.throttled = false;
+		if (tzc_telemetry.set_int != NULL) {
+			tzc_telemetry.set_int(true);
+		}
+	}
+}
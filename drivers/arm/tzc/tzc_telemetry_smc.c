@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <drivers/arm/tzc_telemetry.h>
+
+/*
+ * SiP interface to the TZC telemetry:
+ *
+ *  GET_STATS(filter): returns the number of faults of the filter, the total
+ *                     number of faults and the number of times the interrupt
+ *                     was masked by the rate limiter.
+ *  GET_REGION(region): returns the number of faults that hit the region.
+ *  GET_FAULT(index):  returns the index-th most recent fault: address low and
+ *                     high words, fail id and an info word holding the filter
+ *                     (bits [7:0]), region (bits [15:8]) and TZC_FAULT_* flags
+ *                     (bits [31:16]).
+ *  REARM():           unmasks a rate limited interrupt. The fault ring and
+ *                     counters are never cleared.
+ */
+uintptr_t tzc_telemetry_smc_handler(uint32_t smc_fid,
+				    u_register_t x1,
+				    u_register_t x2,
+				    u_register_t x3,
+				    u_register_t x4,
+				    void *cookie,
+				    void *handle,
+				    u_register_t flags)
+{
+	tzc_fault_t fault;
+
+	switch (smc_fid) {
+	case TZC_TELEMETRY_GET_STATS:
+		if (x1 >= TZC_TELEMETRY_MAX_FILTERS) {
+			SMC_RET1(handle, TZC_TELEMETRY_INVALID_PARAM);
+		}
+
+		SMC_RET4(handle, TZC_TELEMETRY_SUCCESS,
+			 tzc_telemetry_filter_faults((unsigned int)x1),
+			 tzc_telemetry_total_faults(),
+			 tzc_telemetry_throttle_count());
+
+	case TZC_TELEMETRY_GET_REGION:
+		if (x1 >= TZC_TELEMETRY_MAX_REGIONS) {
+			SMC_RET1(handle, TZC_TELEMETRY_INVALID_PARAM);
+		}
+
+		SMC_RET2(handle, TZC_TELEMETRY_SUCCESS,
+			 tzc_telemetry_region_faults((unsigned int)x1));
+
+	case TZC_TELEMETRY_GET_FAULT:
+		if (tzc_telemetry_get_fault((unsigned int)x1, &fault) != 0) {
+			SMC_RET1(handle, TZC_TELEMETRY_NO_DATA);
+		}
+
+		SMC_RET5(handle, TZC_TELEMETRY_SUCCESS,
+			 (uint32_t)fault.address,
+			 (uint32_t)(fault.address >> 32),
+			 fault.fail_id,
+			 (uint32_t)fault.filter |
+			 ((uint32_t)fault.region << 8) |
+			 ((uint32_t)fault.flags << 16));
+
+	case TZC_TELEMETRY_REARM:
+		tzc_telemetry_rearm();
+		SMC_RET1(handle, TZC_TELEMETRY_SUCCESS);
+
+	default:
+		WARN("Unimplemented TZC telemetry call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,6 +17,7 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/img_parser_mod.h>
 #include <drivers/fwu/fwu.h>
+#include <lib/boot_timeline/boot_timeline.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
 #include <plat/common/platform.h>
 
@@ -94,7 +95,8 @@ static int auth_get_param(const auth_param_type_desc_t *param_type_desc,
  */
 static int auth_hash(const auth_method_param_hash_t *param,
 		     const auth_img_desc_t *img_desc,
-		     void *img, unsigned int img_len)
+		     void *img, unsigned int img_len,
+		     const unsigned char *img_hash, unsigned int img_hash_len)
 {
 	void *data_ptr, *hash_der_ptr;
 	unsigned int data_len, hash_der_len;
@@ -111,6 +113,21 @@ static int auth_hash(const auth_method_param_hash_t *param,
 			img, img_len, &data_ptr, &data_len);
 	return_if_error(rc);
 
+#if BL1_FWU_STREAM_HASH
+	/*
+	 * If the hash of the whole image has already been calculated, compare
+	 * it first. On mismatch, e.g. because the parent image uses another
+	 * hash algorithm, fall back to hashing the data again.
+	 */
+	if ((img_hash != NULL) && (data_ptr == img) && (data_len == img_len)) {
+		rc = crypto_mod_hash_stream_verify(img_hash, img_hash_len,
+						   hash_der_ptr, hash_der_len);
+		if (rc == 0) {
+			return 0;
+		}
+	}
+#endif /* BL1_FWU_STREAM_HASH */
+
 	/* Ask the crypto module to verify this hash */
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
@@ -347,13 +364,16 @@ void auth_mod_init(void)
 }
 
 /*
- * Authenticate a certificate/image
+ * Authenticate a certificate/image. If not NULL, img_hash holds the hash of
+ * the whole image, calculated beforehand.
  *
  * Return: 0 = success, Otherwise = error
  */
-int auth_mod_verify_img(unsigned int img_id,
-			void *img_ptr,
-			unsigned int img_len)
+static int auth_mod_verify(unsigned int img_id,
+			   void *img_ptr,
+			   unsigned int img_len,
+			   const unsigned char *img_hash,
+			   unsigned int img_hash_len)
 {
 	const auth_img_desc_t *img_desc = NULL;
 	const auth_method_desc_t *auth_method = NULL;
@@ -363,6 +383,7 @@ int auth_mod_verify_img(unsigned int img_id,
 	unsigned int cert_nv_ctr = 0;
 	bool need_nv_ctr_upgrade = false;
 	bool sig_auth_done = false;
+	unsigned int tl_event;
 	const auth_method_param_nv_ctr_t *nv_ctr_param = NULL;
 
 	/* Get the image descriptor from the chain of trust */
@@ -383,12 +404,19 @@ int auth_mod_verify_img(unsigned int img_id,
 			rc = 0;
 			break;
 		case AUTH_METHOD_HASH:
+			tl_event = boot_timeline_begin(BOOT_TL_PHASE_HASH,
+						       img_id);
 			rc = auth_hash(&auth_method->param.hash,
-					img_desc, img_ptr, img_len);
+					img_desc, img_ptr, img_len,
+					img_hash, img_hash_len);
+			boot_timeline_end(tl_event);
 			break;
 		case AUTH_METHOD_SIG:
+			tl_event = boot_timeline_begin(BOOT_TL_PHASE_SIGNATURE,
+						       img_id);
 			rc = auth_signature(&auth_method->param.sig,
 					img_desc, img_ptr, img_len);
+			boot_timeline_end(tl_event);
 			sig_auth_done = true;
 			break;
 		case AUTH_METHOD_NV_CTR:
@@ -445,3 +473,34 @@ int auth_mod_verify_img(unsigned int img_id,
 
 	return 0;
 }
+
+/*
+ * Authenticate a certificate/image
+ *
+ * Return: 0 = success, Otherwise = error
+ */
+int auth_mod_verify_img(unsigned int img_id,
+			void *img_ptr,
+			unsigned int img_len)
+{
+	return auth_mod_verify(img_id, img_ptr, img_len, NULL, 0U);
+}
+
+#if BL1_FWU_STREAM_HASH
+/*
+ * Same as auth_mod_verify_img(), for an image whose hash has already been
+ * calculated with crypto_mod_hash_stream_*(). The hash is used instead of
+ * hashing the image again when the image is authenticated by hash.
+ */
+int auth_mod_verify_img_hash(unsigned int img_id,
+			     void *img_ptr,
+			     unsigned int img_len,
+			     const unsigned char *img_hash,
+			     unsigned int img_hash_len)
+{
+	assert(img_hash != NULL);
+
+	return auth_mod_verify(img_id, img_ptr, img_len, img_hash,
+			       img_hash_len);
+}
+#endif /* BL1_FWU_STREAM_HASH */
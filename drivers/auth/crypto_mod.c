@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -104,7 +104,7 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 					   digest_info_ptr, digest_info_len);
 }
 
-#if MEASURED_BOOT
+#if MEASURED_BOOT || OPTEE_PAGEABLE_HASHES
 /*
  * Calculate a hash
  *
@@ -123,7 +123,71 @@ int crypto_mod_calc_hash(unsigned int alg, void *data_ptr,
 
 	return crypto_lib_desc.calc_hash(alg, data_ptr, data_len, output);
 }
-#endif	/* MEASURED_BOOT */
+#endif	/* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
+
+#if BL1_FWU_STREAM_HASH
+/*
+ * Start an incremental hash calculation
+ */
+int crypto_mod_hash_stream_start(void)
+{
+	return crypto_hash_stream_desc.start();
+}
+
+/*
+ * Add data to the incremental hash calculation in progress
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: data to be hashed
+ */
+int crypto_mod_hash_stream_update(const void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+
+	return crypto_hash_stream_desc.update(data_ptr, data_len);
+}
+
+/*
+ * Complete the incremental hash calculation in progress
+ *
+ * Parameters:
+ *
+ *   output: resulting hash, CRYPTO_MAX_HASH_SIZE bytes long
+ *   output_len: size of the resulting hash
+ */
+int crypto_mod_hash_stream_finish(unsigned char *output,
+				  unsigned int *output_len)
+{
+	assert(output != NULL);
+	assert(output_len != NULL);
+
+	return crypto_hash_stream_desc.finish(output, output_len);
+}
+
+/*
+ * Verify a hash calculated incrementally by comparison
+ *
+ * Parameters:
+ *
+ *   hash_ptr, hash_len: hash returned by crypto_mod_hash_stream_finish()
+ *   digest_info_ptr, digest_info_len: hash to be compared
+ */
+int crypto_mod_hash_stream_verify(const unsigned char *hash_ptr,
+				  unsigned int hash_len,
+				  void *digest_info_ptr,
+				  unsigned int digest_info_len)
+{
+	assert(hash_ptr != NULL);
+	assert(hash_len != 0);
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0);
+
+	return crypto_hash_stream_desc.verify(hash_ptr, hash_len,
+					      digest_info_ptr, digest_info_len);
+}
+#endif	/* BL1_FWU_STREAM_HASH */
 
 /*
  * Authenticated decryption of data
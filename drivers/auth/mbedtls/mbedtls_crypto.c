@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -20,6 +20,7 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/mbedtls/mbedtls_common.h>
 #include <drivers/auth/mbedtls/mbedtls_config.h>
+#include <lib/cassert.h>
 #include <plat/common/platform.h>
 
 #define LIB_NAME		"mbed TLS"
@@ -140,19 +141,18 @@ end2:
 }
 
 /*
- * Match a hash
+ * Get the hash algorithm and the hash value from a DigestInfo
  *
  * Digest info is passed in DER format following the ASN.1 structure detailed
  * above.
  */
-static int verify_hash(void *data_ptr, unsigned int data_len,
-		       void *digest_info_ptr, unsigned int digest_info_len)
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   const mbedtls_md_info_t **md_info,
+			   unsigned char **hash)
 {
 	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
-	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
-	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	unsigned char *p, *end;
 	size_t len;
 	int rc;
 
@@ -176,8 +176,8 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 		return CRYPTO_ERR_HASH;
 	}
 
-	md_info = mbedtls_md_info_from_type(md_alg);
-	if (md_info == NULL) {
+	*md_info = mbedtls_md_info_from_type(md_alg);
+	if (*md_info == NULL) {
 		return CRYPTO_ERR_HASH;
 	}
 
@@ -188,10 +188,32 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 
 	/* Length of hash must match the algorithm's size */
-	if (len != mbedtls_md_get_size(md_info)) {
+	if (len != mbedtls_md_get_size(*md_info)) {
 		return CRYPTO_ERR_HASH;
 	}
-	hash = p;
+	*hash = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Match a hash
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash(void *data_ptr, unsigned int data_len,
+		       void *digest_info_ptr, unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *p, *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != 0) {
+		return rc;
+	}
 
 	/* Calculate the hash of the data */
 	p = (unsigned char *)data_ptr;
@@ -209,7 +231,104 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	return CRYPTO_SUCCESS;
 }
 
-#if MEASURED_BOOT
+#if BL1_FWU_STREAM_HASH
+#if TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA384
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA384
+#elif TF_MBEDTLS_HASH_ALG_ID == TF_MBEDTLS_SHA512
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA512
+#else
+#define STREAM_MD_TYPE		MBEDTLS_MD_SHA256
+#endif
+
+CASSERT(MBEDTLS_MD_MAX_SIZE <= CRYPTO_MAX_HASH_SIZE,
+	assert_crypto_max_hash_size_too_small);
+
+/* Context of the incremental hash calculation in progress */
+static mbedtls_md_context_t stream_md_ctx;
+
+/*
+ * Start an incremental hash calculation with the configured hash algorithm
+ */
+static int hash_stream_start(void)
+{
+	const mbedtls_md_info_t *md_info;
+	int rc;
+
+	md_info = mbedtls_md_info_from_type(STREAM_MD_TYPE);
+	if (md_info == NULL) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Release the context of any calculation left in progress */
+	mbedtls_md_free(&stream_md_ctx);
+	mbedtls_md_init(&stream_md_ctx);
+
+	rc = mbedtls_md_setup(&stream_md_ctx, md_info, 0);
+	if (rc == 0) {
+		rc = mbedtls_md_starts(&stream_md_ctx);
+	}
+
+	if (rc != 0) {
+		mbedtls_md_free(&stream_md_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_update(const void *data_ptr, unsigned int data_len)
+{
+	if (mbedtls_md_update(&stream_md_ctx, data_ptr, data_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int hash_stream_finish(unsigned char *output, unsigned int *output_len)
+{
+	int rc;
+
+	rc = mbedtls_md_finish(&stream_md_ctx, output);
+	*output_len = mbedtls_md_get_size(
+				mbedtls_md_info_from_type(STREAM_MD_TYPE));
+	mbedtls_md_free(&stream_md_ctx);
+
+	return (rc == 0) ? CRYPTO_SUCCESS : CRYPTO_ERR_HASH;
+}
+
+/*
+ * Compare a hash calculated with the configured hash algorithm with the one
+ * in a DigestInfo. A DigestInfo using another algorithm never matches.
+ */
+static int hash_stream_verify(const unsigned char *hash_ptr,
+			      unsigned int hash_len,
+			      void *digest_info_ptr,
+			      unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if ((mbedtls_md_get_type(md_info) != STREAM_MD_TYPE) ||
+	    (hash_len != mbedtls_md_get_size(md_info))) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	if (memcmp(hash_ptr, hash, hash_len) != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+#endif /* BL1_FWU_STREAM_HASH */
+
+#if MEASURED_BOOT || OPTEE_PAGEABLE_HASHES
 /*
  * Calculate a hash
  *
@@ -228,7 +347,7 @@ int calc_hash(unsigned int alg, void *data_ptr,
 	/* Calculate the hash of the data */
 	return mbedtls_md(md_info, data_ptr, data_len, output);
 }
-#endif /* MEASURED_BOOT */
+#endif /* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
 
 #if TF_MBEDTLS_USE_AES_GCM
 /*
@@ -332,7 +451,7 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 /*
  * Register crypto library descriptor
  */
-#if MEASURED_BOOT
+#if MEASURED_BOOT || OPTEE_PAGEABLE_HASHES
 #if TF_MBEDTLS_USE_AES_GCM
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
 		    auth_decrypt);
@@ -340,11 +459,16 @@ REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
 		    NULL);
 #endif
-#else /* MEASURED_BOOT */
+#else /* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
 #if TF_MBEDTLS_USE_AES_GCM
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash,
 		    auth_decrypt);
 #else
 REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL);
 #endif
-#endif /* MEASURED_BOOT */
+#endif /* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
+
+#if BL1_FWU_STREAM_HASH
+REGISTER_CRYPTO_HASH_STREAM(hash_stream_start, hash_stream_update,
+			    hash_stream_finish, hash_stream_verify);
+#endif /* BL1_FWU_STREAM_HASH */
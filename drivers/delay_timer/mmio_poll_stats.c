@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <common/debug.h>
+#include <drivers/mmio_poll.h>
+#include <lib/utils_def.h>
+
+IMPORT_SYM(uintptr_t, __MMIO_POLL_STATS_START__, MMIO_POLL_STATS_START);
+IMPORT_SYM(uintptr_t, __MMIO_POLL_STATS_END__, MMIO_POLL_STATS_END);
+
+/***********************************************************
+ * Print the statistics of every mmio_poll_timeout() call
+ * site of the image that has been executed at least once.
+ * Times are reported in microseconds.
+ ***********************************************************/
+void mmio_poll_stats_dump(void)
+{
+	const mmio_poll_stats_t *site;
+	uint64_t ticks_per_ms = timeout_cnt_us2cnt(1000U);
+
+	if (ticks_per_ms == 0U) {
+		return;
+	}
+
+	for (site = (const mmio_poll_stats_t *)MMIO_POLL_STATS_START;
+	     site < (const mmio_poll_stats_t *)MMIO_POLL_STATS_END; site++) {
+		if (site->calls == 0U) {
+			continue;
+		}
+
+		INFO("mmio_poll %s:%u calls %u timeouts %u avg %llu max %llu\n",
+		     site->func, site->line, site->calls, site->timeouts,
+		     (unsigned long long)(((site->total_ticks / site->calls) *
+					   1000U) / ticks_per_ms),
+		     (unsigned long long)((site->max_ticks * 1000U) /
+					  ticks_per_ms));
+	}
+}
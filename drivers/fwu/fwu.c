@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stddef.h>
 
 #include <common/debug.h>
 #include <common/tf_crc32.h>
@@ -24,6 +25,9 @@
 CASSERT((offsetof(struct fwu_metadata, crc_32) == 0),
 	crc_32_must_be_first_member_of_structure);
 
+CASSERT(NR_OF_FW_BANKS <= FWU_METADATA_MAX_BANKS,
+	assert_fwu_nr_of_fw_banks);
+
 static struct fwu_metadata metadata;
 static bool is_fwu_initialized;
 
@@ -55,12 +59,41 @@ static int fwu_metadata_crc_check(void)
  ******************************************************************************/
 static int fwu_metadata_sanity_check(void)
 {
-	/* ToDo: add more conditions for sanity check */
+	const struct fwu_fw_store_desc *desc = &metadata.fw_desc;
+
+	if (metadata.version != FWU_METADATA_VERSION) {
+		return -1;
+	}
+
 	if ((metadata.active_index >= NR_OF_FW_BANKS) ||
 	    (metadata.previous_active_index >= NR_OF_FW_BANKS)) {
 		return -1;
 	}
 
+	/* The metadata layout must match the one TF-A was built for */
+	if ((metadata.metadata_size != sizeof(struct fwu_metadata)) ||
+	    (metadata.desc_offset != offsetof(struct fwu_metadata, fw_desc)) ||
+	    (desc->num_banks != NR_OF_FW_BANKS) ||
+	    (desc->num_images != NR_OF_IMAGES_IN_FW_BANK) ||
+	    (desc->img_entry_size != sizeof(struct fwu_image_entry)) ||
+	    (desc->bank_info_entry_size !=
+	     sizeof(struct fwu_image_bank_info))) {
+		return -1;
+	}
+
+	for (unsigned int i = 0U; i < NR_OF_FW_BANKS; i++) {
+		if ((metadata.bank_state[i] != FWU_BANK_STATE_ACCEPTED) &&
+		    (metadata.bank_state[i] != FWU_BANK_STATE_VALID) &&
+		    (metadata.bank_state[i] != FWU_BANK_STATE_INVALID)) {
+			return -1;
+		}
+	}
+
+	if (metadata.bank_state[metadata.active_index] ==
+	    FWU_BANK_STATE_INVALID) {
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -133,28 +166,123 @@ exit:
 }
 
 /*******************************************************************************
- * The system runs in the trial run state if any of the images in the active
- * firmware bank has not been accepted yet.
+ * Check whether the given bank holds images that have not all been accepted yet.
+ ******************************************************************************/
+static bool fwu_bank_is_trial(const struct fwu_metadata *md, uint32_t bank)
+{
+	if (md->bank_state[bank] != FWU_BANK_STATE_ACCEPTED) {
+		return true;
+	}
+
+	for (unsigned int i = 0U; i < NR_OF_IMAGES_IN_FW_BANK; i++) {
+		const struct fwu_image_entry *entry = &md->fw_desc.img_entry[i];
+
+		if (entry->img_bank_info[bank].accepted == 0U) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#if PSA_FWU_TRIAL_BOOT_MAX
+/*******************************************************************************
+ * Select the bank to boot from, based on the FWU metadata and on the number of
+ * boot attempts already made with the images of the active bank.
  *
- * Returns true if the system is running in the trial state.
+ * @md: FWU metadata, its active_index is updated on rollback.
+ * @boot_count: number of boot attempts made with the current metadata, updated
+ *		to account for this boot.
+ *
+ * While the active bank is in trial state, each boot is counted. Once
+ * PSA_FWU_TRIAL_BOOT_MAX attempts have been made without the bank being
+ * accepted, the previous active bank is booted instead. The bank in trial is
+ * then marked invalid in the local copy of the metadata only, it is up to the
+ * updater to rewrite the metadata.
+ *
+ * return true if the system rolled back to the previous active bank.
  ******************************************************************************/
-bool fwu_is_trial_run_state(void)
+static bool fwu_metadata_select_bank(struct fwu_metadata *md,
+				     uint32_t *boot_count)
 {
-	bool trial_run = false;
+	uint32_t prev = md->previous_active_index;
 
-	assert(is_fwu_initialized == true);
+	if (!fwu_bank_is_trial(md, md->active_index)) {
+		return false;
+	}
 
-	for (unsigned int i = 0U; i < NR_OF_IMAGES_IN_FW_BANK; i++) {
-		struct fwu_image_entry *entry = &metadata.img_entry[i];
-		struct fwu_image_properties *img_props =
-			&entry->img_props[metadata.active_index];
-		if (img_props->accepted == 0) {
-			trial_run = true;
-			break;
+	if (*boot_count < PSA_FWU_TRIAL_BOOT_MAX) {
+		(*boot_count)++;
+		return false;
+	}
+
+	if ((prev == md->active_index) ||
+	    (md->bank_state[prev] == FWU_BANK_STATE_INVALID)) {
+		/* Nothing to fall back to, keep booting the trial bank */
+		return false;
+	}
+
+	md->bank_state[md->active_index] = FWU_BANK_STATE_INVALID;
+	md->active_index = prev;
+
+	return true;
+}
+
+/*******************************************************************************
+ * Apply the trial boot policy to the loaded FWU metadata. The boot attempt
+ * counter is kept by the platform along with the CRC32 of the metadata it
+ * applies to, so that it restarts from zero as soon as the updater writes new
+ * metadata.
+ ******************************************************************************/
+static void fwu_trial_boot_check(void)
+{
+	uint32_t trial_bank = metadata.active_index;
+	uint32_t md_crc, count, prev_count;
+	int result;
+
+	result = plat_fwu_get_boot_attempts(&md_crc, &count);
+	if (result != 0) {
+		WARN("Failed to read FWU boot attempts (%i)\n", result);
+		return;
+	}
+
+	if (md_crc != metadata.crc_32) {
+		count = 0U;
+	}
+
+	prev_count = count;
+
+	if (fwu_metadata_select_bank(&metadata, &count)) {
+		WARN("FWU: bank %u not accepted after %u boots, "
+		     "rolling back to bank %u\n",
+		     trial_bank, count, metadata.active_index);
+		return;
+	}
+
+	if (count != prev_count) {
+		INFO("FWU: trial boot %u of %u\n", count,
+		     PSA_FWU_TRIAL_BOOT_MAX);
+
+		result = plat_fwu_set_boot_attempts(metadata.crc_32, count);
+		if (result != 0) {
+			WARN("Failed to update FWU boot attempts (%i)\n",
+			     result);
 		}
 	}
+}
+#endif /* PSA_FWU_TRIAL_BOOT_MAX */
+
+/*******************************************************************************
+ * The system runs in the trial run state if the active firmware bank has not
+ * been accepted yet, or if any of its images has not been accepted yet.
+ *
+ * Returns true if the system is running in the trial state.
+ ******************************************************************************/
+bool fwu_is_trial_run_state(void)
+{
+	assert(is_fwu_initialized == true);
 
-	return trial_run;
+	return fwu_bank_is_trial(&metadata, metadata.active_index);
 }
 
 /*******************************************************************************
@@ -181,6 +309,10 @@ void fwu_init(void)
 		}
 	}
 
+#if PSA_FWU_TRIAL_BOOT_MAX
+	fwu_trial_boot_check();
+#endif /* PSA_FWU_TRIAL_BOOT_MAX */
+
 	plat_fwu_set_images_source(&metadata);
 
 	is_fwu_initialized = true;
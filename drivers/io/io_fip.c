@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -73,6 +73,8 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 static int fip_file_len(io_entity_t *entity, size_t *length);
 static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			  size_t *length_read);
+static int fip_file_map(io_entity_t *entity, size_t length,
+			uintptr_t *address);
 static int fip_file_close(io_entity_t *entity);
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
 static int fip_dev_close(io_dev_info_t *dev_info);
@@ -114,6 +116,7 @@ static const io_dev_funcs_t fip_dev_funcs = {
 	.size = fip_file_len,
 	.read = fip_file_read,
 	.write = NULL,
+	.map = fip_file_map,
 	.close = fip_file_close,
 	.dev_init = fip_dev_init,
 	.dev_close = fip_dev_close,
@@ -431,6 +434,48 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
+/*
+ * Return the address of the data at the current file position, if the FIP is
+ * stored on a memory-mapped device.
+ */
+static int fip_file_map(io_entity_t *entity, size_t length,
+			uintptr_t *address)
+{
+	int result;
+	fip_file_state_t *fp;
+	size_t file_offset;
+	uintptr_t backend_handle;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	fp = (fip_file_state_t *)entity->info;
+
+	if (length > (fp->entry.size - fp->file_pos)) {
+		return -EINVAL;
+	}
+
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		return -ENOENT;
+	}
+
+	/* Seek to the position in the FIP where the payload lives */
+	file_offset = fp->entry.offset_address + fp->file_pos;
+	result = io_seek(backend_handle, IO_SEEK_SET,
+			 (signed long long)file_offset);
+	if (result == 0) {
+		result = io_map(backend_handle, length, address);
+	}
+
+	io_close(backend_handle);
+
+	return result;
+}
+
+
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -48,6 +48,8 @@ static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 			     size_t length, size_t *length_read);
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written);
+static int memmap_block_map(io_entity_t *entity, size_t length,
+			    uintptr_t *address);
 static int memmap_block_close(io_entity_t *entity);
 static int memmap_dev_close(io_dev_info_t *dev_info);
 
@@ -64,6 +66,7 @@ static const io_dev_funcs_t memmap_dev_funcs = {
 	.size = memmap_block_len,
 	.read = memmap_block_read,
 	.write = memmap_block_write,
+	.map = memmap_block_map,
 	.close = memmap_block_close,
 	.dev_init = NULL,
 	.dev_close = memmap_dev_close,
@@ -221,6 +224,29 @@ static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 }
 
 
+/* Return the address of the data at the current file position */
+static int memmap_block_map(io_entity_t *entity, size_t length,
+			    uintptr_t *address)
+{
+	memmap_file_state_t *fp;
+	unsigned long long pos_after;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+
+	fp = (memmap_file_state_t *) entity->info;
+
+	pos_after = fp->file_pos + length;
+	if ((pos_after < fp->file_pos) || (pos_after > fp->size)) {
+		return -EINVAL;
+	}
+
+	*address = (uintptr_t)(fp->base + fp->file_pos);
+
+	return 0;
+}
+
+
 /* Close a file on the memmap device */
 static int memmap_block_close(io_entity_t *entity)
 {
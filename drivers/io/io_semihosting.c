@@ -1,17 +1,84 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include <platform_def.h>
 
+#include <common/debug.h>
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_semihosting.h>
 #include <drivers/io/io_storage.h>
 #include <lib/semihosting.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+
+/*
+ * Number of files kept open on the host once they have been closed by the
+ * IO layer, so that reopening them does not trap to the debugger again.
+ */
+#ifndef PLAT_SEMIHOSTING_FILE_CACHE_SIZE
+#define PLAT_SEMIHOSTING_FILE_CACHE_SIZE	U(8)
+#endif
+
+/*
+ * Optionally, files read in small chunks are preloaded into a memory buffer of
+ * the platform, defined by PLAT_SEMIHOSTING_PRELOAD_BASE and
+ * PLAT_SEMIHOSTING_PRELOAD_SIZE.
+ */
+#if defined(PLAT_SEMIHOSTING_PRELOAD_BASE) && \
+	!defined(PLAT_SEMIHOSTING_PRELOAD_SIZE)
+#error "PLAT_SEMIHOSTING_PRELOAD_SIZE must be defined"
+#endif
+
+#define SH_MAX_HOST_FILES	(MAX_IO_HANDLES + PLAT_SEMIHOSTING_FILE_CACHE_SIZE)
+
+/* File held open on the host */
+typedef struct {
+	const char *path;
+	unsigned int mode;
+	long handle;
+	/* Number of IO entities using the file, 0 if only cached */
+	unsigned int users;
+	/* Access stamp, used to evict the least recently used file */
+	unsigned int stamp;
+	/* Length of the file, cached on the first request */
+	size_t length;
+	bool length_valid;
+	/* Current position of the file on the host */
+	size_t host_pos;
+	/* Address of the content of the file, if it has been preloaded */
+	uintptr_t preload;
+} sh_host_file_t;
+
+/* State of a file opened through the IO layer */
+typedef struct {
+	sh_host_file_t *file;
+	size_t pos;
+} sh_file_state_t;
+
+static sh_host_file_t sh_host_files[SH_MAX_HOST_FILES];
+static sh_file_state_t sh_file_states[MAX_IO_HANDLES];
+static unsigned int sh_stamp;
+
+#ifdef PLAT_SEMIHOSTING_PRELOAD_BASE
+/* Free space left in the preload buffer */
+static uintptr_t sh_preload_free = PLAT_SEMIHOSTING_PRELOAD_BASE;
+#endif
+
+/* Number of traps avoided, per semihosting operation */
+static struct {
+	unsigned int open;
+	unsigned int flen;
+	unsigned int seek;
+	unsigned int read;
+	unsigned int close;
+} sh_saved;
 
 /* Identify the device type as semihosting */
 static io_type_t device_type_sh(void)
@@ -31,6 +98,7 @@ static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		size_t *length_read);
 static int sh_file_write(io_entity_t *entity, const uintptr_t buffer,
 		size_t length, size_t *length_written);
+static int sh_file_map(io_entity_t *entity, size_t length, uintptr_t *address);
 static int sh_file_close(io_entity_t *entity);
 
 static const io_dev_connector_t sh_dev_connector = {
@@ -45,6 +113,7 @@ static const io_dev_funcs_t sh_dev_funcs = {
 	.size = sh_file_len,
 	.read = sh_file_read,
 	.write = sh_file_write,
+	.map = sh_file_map,
 	.close = sh_file_close,
 	.dev_init = NULL,	/* NOP */
 	.dev_close = NULL,	/* NOP */
@@ -57,6 +126,169 @@ static io_dev_info_t sh_dev_info = {
 };
 
 
+/* Only files opened for reading are kept open on the host */
+static bool sh_mode_is_cacheable(unsigned int mode)
+{
+	return (mode == FOPEN_MODE_R) || (mode == FOPEN_MODE_RB);
+}
+
+
+static void sh_host_file_release(sh_host_file_t *file)
+{
+	if (file->handle > 0) {
+		(void)semihosting_file_close(file->handle);
+	}
+
+	file->path = NULL;
+}
+
+
+/*
+ * Return the host file of a path, opening it if it is not cached. When all
+ * the entries are used, the least recently used file that is not open through
+ * the IO layer is closed on the host.
+ */
+static sh_host_file_t *sh_host_file_get(const char *path, unsigned int mode)
+{
+	sh_host_file_t *file;
+	sh_host_file_t *victim = NULL;
+	long sh_result;
+	unsigned int i;
+
+	if (sh_mode_is_cacheable(mode)) {
+		for (i = 0U; i < SH_MAX_HOST_FILES; i++) {
+			file = &sh_host_files[i];
+			if ((file->path != NULL) && (file->mode == mode) &&
+			    (strcmp(file->path, path) == 0)) {
+				sh_saved.open++;
+				return file;
+			}
+		}
+	}
+
+	for (i = 0U; i < SH_MAX_HOST_FILES; i++) {
+		file = &sh_host_files[i];
+		if (file->path == NULL) {
+			victim = file;
+			break;
+		}
+
+		if ((file->users == 0U) &&
+		    ((victim == NULL) || (file->stamp < victim->stamp))) {
+			victim = file;
+		}
+	}
+
+	if (victim == NULL) {
+		return NULL;
+	}
+
+	if (victim->path != NULL) {
+		sh_host_file_release(victim);
+	}
+
+	sh_result = semihosting_file_open(path, mode);
+	if (sh_result <= 0) {
+		return NULL;
+	}
+
+	zeromem(victim, sizeof(*victim));
+	victim->path = path;
+	victim->mode = mode;
+	victim->handle = sh_result;
+
+	return victim;
+}
+
+
+/* Get the length of a host file, querying the host only once */
+static int sh_host_file_len(sh_host_file_t *file, size_t *length)
+{
+	long sh_result;
+
+	if (file->length_valid) {
+		sh_saved.flen++;
+		*length = file->length;
+		return 0;
+	}
+
+	sh_result = semihosting_file_length(file->handle);
+	if (sh_result < 0) {
+		return -ENOENT;
+	}
+
+	*length = (size_t)sh_result;
+
+	/* The length of a file open for writing may change */
+	if (sh_mode_is_cacheable(file->mode)) {
+		file->length = (size_t)sh_result;
+		file->length_valid = true;
+	}
+
+	return 0;
+}
+
+
+/* Move the host position of a file, unless it is already there */
+static int sh_host_file_seek(sh_host_file_t *file, size_t pos)
+{
+	if (file->host_pos == pos) {
+		sh_saved.seek++;
+		return 0;
+	}
+
+	if (semihosting_file_seek(file->handle, (ssize_t)pos) != 0) {
+		return -ENOENT;
+	}
+
+	file->host_pos = pos;
+
+	return 0;
+}
+
+
+#ifdef PLAT_SEMIHOSTING_PRELOAD_BASE
+/*
+ * Read a whole file into the preload buffer in a single trap, so that the
+ * following reads of the file are served from memory. This is done when a file
+ * is read in small chunks, e.g. when it is a FIP whose header and images are
+ * read separately. The host handle is not needed anymore afterwards.
+ */
+static void sh_host_file_preload(sh_host_file_t *file)
+{
+	uintptr_t end = PLAT_SEMIHOSTING_PRELOAD_BASE +
+			PLAT_SEMIHOSTING_PRELOAD_SIZE;
+	size_t length, bytes;
+
+	if (!sh_mode_is_cacheable(file->mode) || (sh_preload_free >= end) ||
+	    (sh_host_file_len(file, &length) != 0) || (length == 0U) ||
+	    (length > (end - sh_preload_free))) {
+		return;
+	}
+
+	if (sh_host_file_seek(file, 0U) != 0) {
+		return;
+	}
+
+	bytes = length;
+	if ((semihosting_file_read(file->handle, &bytes, sh_preload_free) != 0) ||
+	    (bytes != length)) {
+		file->host_pos = SIZE_MAX;
+		return;
+	}
+
+	VERBOSE("Semihosting: preloaded %s at 0x%lx (%zu bytes)\n",
+		file->path, sh_preload_free, length);
+
+	file->preload = sh_preload_free;
+	sh_preload_free += round_up(length, sizeof(uint64_t));
+
+	(void)semihosting_file_close(file->handle);
+	file->handle = 0;
+}
+#endif /* PLAT_SEMIHOSTING_PRELOAD_BASE */
+
+
 /* Open a connection to the semi-hosting device */
 static int sh_dev_open(const uintptr_t dev_spec __unused,
 		io_dev_info_t **dev_info)
@@ -71,55 +303,72 @@ static int sh_dev_open(const uintptr_t dev_spec __unused,
 static int sh_file_open(io_dev_info_t *dev_info __unused,
 		const uintptr_t spec, io_entity_t *entity)
 {
-	int result = -ENOENT;
-	long sh_result;
 	const io_file_spec_t *file_spec = (const io_file_spec_t *)spec;
+	sh_file_state_t *state = NULL;
+	sh_host_file_t *file;
+	unsigned int i;
 
 	assert(file_spec != NULL);
 	assert(entity != NULL);
 
-	sh_result = semihosting_file_open(file_spec->path, file_spec->mode);
+	for (i = 0U; i < MAX_IO_HANDLES; i++) {
+		if (sh_file_states[i].file == NULL) {
+			state = &sh_file_states[i];
+			break;
+		}
+	}
 
-	if (sh_result > 0) {
-		entity->info = (uintptr_t)sh_result;
-		result = 0;
+	if (state == NULL) {
+		return -ENOMEM;
 	}
-	return result;
+
+	file = sh_host_file_get(file_spec->path, file_spec->mode);
+	if (file == NULL) {
+		return -ENOENT;
+	}
+
+	file->users++;
+	file->stamp = ++sh_stamp;
+
+	state->file = file;
+	state->pos = 0U;
+	entity->info = (uintptr_t)state;
+
+	return 0;
 }
 
 
 /* Seek to a particular file offset on the semi-hosting device */
 static int sh_file_seek(io_entity_t *entity, int mode, signed long long offset)
 {
-	long file_handle, sh_result;
+	sh_file_state_t *state;
 
 	assert(entity != NULL);
 
-	file_handle = (long)entity->info;
+	state = (sh_file_state_t *)entity->info;
 
-	sh_result = semihosting_file_seek(file_handle, (ssize_t)offset);
+	if (offset < 0) {
+		return -ENOENT;
+	}
 
-	return (sh_result == 0) ? 0 : -ENOENT;
+	/* The host file is only moved by the next read or write */
+	state->pos = (size_t)offset;
+
+	return 0;
 }
 
 
 /* Return the size of a file on the semi-hosting device */
 static int sh_file_len(io_entity_t *entity, size_t *length)
 {
-	int result = -ENOENT;
+	sh_file_state_t *state;
 
 	assert(entity != NULL);
 	assert(length != NULL);
 
-	long sh_handle = (long)entity->info;
-	long sh_result = semihosting_file_length(sh_handle);
+	state = (sh_file_state_t *)entity->info;
 
-	if (sh_result >= 0) {
-		result = 0;
-		*length = (size_t)sh_result;
-	}
-
-	return result;
+	return sh_host_file_len(state->file, length);
 }
 
 
@@ -127,24 +376,59 @@ static int sh_file_len(io_entity_t *entity, size_t *length)
 static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		size_t *length_read)
 {
-	int result = -ENOENT;
-	long sh_result;
+	sh_file_state_t *state;
+	sh_host_file_t *file;
 	size_t bytes = length;
-	long file_handle;
 
 	assert(entity != NULL);
 	assert(length_read != NULL);
 
-	file_handle = (long)entity->info;
+	state = (sh_file_state_t *)entity->info;
+	file = state->file;
 
-	sh_result = semihosting_file_read(file_handle, &bytes, buffer);
+#ifdef PLAT_SEMIHOSTING_PRELOAD_BASE
+	size_t file_len;
 
-	if (sh_result >= 0) {
-		*length_read = (bytes != length) ? bytes : length;
-		result = 0;
+	/* Reads of a whole file are done directly into the destination */
+	if ((file->preload == 0U) &&
+	    ((state->pos != 0U) || (sh_host_file_len(file, &file_len) != 0) ||
+	     (length < file_len))) {
+		sh_host_file_preload(file);
+	}
+#endif
+
+	if (file->preload != 0U) {
+		/* Both the length and the content are known */
+		if (state->pos >= file->length) {
+			return -ENOENT;
+		}
+
+		bytes = MIN(length, file->length - state->pos);
+		(void)memcpy((void *)buffer,
+			     (const void *)(file->preload + state->pos), bytes);
+		sh_saved.read++;
+	} else {
+		/*
+		 * The data is read in a single trap, directly into the
+		 * destination buffer.
+		 */
+		if (sh_host_file_seek(file, state->pos) != 0) {
+			return -ENOENT;
+		}
+
+		if (semihosting_file_read(file->handle, &bytes, buffer) < 0) {
+			/* The host position is unknown after a failed read */
+			file->host_pos = SIZE_MAX;
+			return -ENOENT;
+		}
+
+		file->host_pos += bytes;
 	}
 
-	return result;
+	state->pos += bytes;
+	*length_read = bytes;
+
+	return 0;
 }
 
 
@@ -152,34 +436,89 @@ static int sh_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 static int sh_file_write(io_entity_t *entity, const uintptr_t buffer,
 		size_t length, size_t *length_written)
 {
+	sh_file_state_t *state;
+	sh_host_file_t *file;
 	long sh_result;
-	long file_handle;
 	size_t bytes = length;
 
 	assert(entity != NULL);
 	assert(length_written != NULL);
 
-	file_handle = (long)entity->info;
+	state = (sh_file_state_t *)entity->info;
+	file = state->file;
+
+	if ((file->preload != 0U) ||
+	    (sh_host_file_seek(file, state->pos) != 0)) {
+		return -ENOENT;
+	}
 
-	sh_result = semihosting_file_write(file_handle, &bytes, buffer);
+	sh_result = semihosting_file_write(file->handle, &bytes, buffer);
 
 	*length_written = length - bytes;
+	state->pos += *length_written;
+	file->host_pos += *length_written;
 
 	return (sh_result == 0) ? 0 : -ENOENT;
 }
 
 
-/* Close a file on the semi-hosting device */
+/*
+ * Return the address of the data at the current file position, which is only
+ * possible if the file has been preloaded.
+ */
+static int sh_file_map(io_entity_t *entity, size_t length, uintptr_t *address)
+{
+	sh_file_state_t *state;
+	sh_host_file_t *file;
+
+	assert(entity != NULL);
+	assert(address != NULL);
+
+	state = (sh_file_state_t *)entity->info;
+	file = state->file;
+
+	if (file->preload == 0U) {
+		return -ENOTSUP;
+	}
+
+	if ((state->pos > file->length) ||
+	    (length > (file->length - state->pos))) {
+		return -EINVAL;
+	}
+
+	*address = file->preload + state->pos;
+
+	return 0;
+}
+
+
+/*
+ * Close a file on the semi-hosting device. Files open for reading are kept
+ * open on the host, until their entry is needed for another file.
+ */
 static int sh_file_close(io_entity_t *entity)
 {
-	long sh_result;
-	long file_handle;
+	sh_file_state_t *state;
+	sh_host_file_t *file;
+	long sh_result = 0;
 
 	assert(entity != NULL);
 
-	file_handle = (long)entity->info;
+	state = (sh_file_state_t *)entity->info;
+	file = state->file;
 
-	sh_result = semihosting_file_close(file_handle);
+	assert(file->users > 0U);
+	file->users--;
+
+	if (!sh_mode_is_cacheable(file->mode) && (file->users == 0U)) {
+		sh_result = semihosting_file_close(file->handle);
+		file->path = NULL;
+	} else {
+		sh_saved.close++;
+	}
+
+	state->file = NULL;
+	entity->info = 0U;
 
 	return (sh_result >= 0) ? 0 : -ENOENT;
 }
@@ -199,3 +538,23 @@ int register_io_dev_sh(const io_dev_connector_t **dev_con)
 
 	return result;
 }
+
+/*
+ * Report the number of traps to the host debugger issued so far, and the
+ * number of traps avoided by caching the files and their content.
+ */
+void io_sh_print_stats(void)
+{
+	INFO("Semihosting: %u traps (open %u, flen %u, seek %u, read %u, close %u)\n",
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_ALL),
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_OPEN),
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_FLEN),
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_SEEK),
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_READ),
+	     semihosting_get_trap_count(SEMIHOSTING_SYS_CLOSE));
+	INFO("Semihosting: %u traps avoided (open %u, flen %u, seek %u, read %u, close %u)\n",
+	     sh_saved.open + sh_saved.flen + sh_saved.seek + sh_saved.read +
+	     sh_saved.close,
+	     sh_saved.open, sh_saved.flen, sh_saved.seek, sh_saved.read,
+	     sh_saved.close);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -285,6 +285,26 @@ int io_read(uintptr_t handle,
 }
 
 
+/*
+ * Get the address at which the next 'length' bytes of an IO entity can be read
+ * in place, if the device is memory-mapped. The file position is not changed.
+ */
+int io_map(uintptr_t handle, size_t length, uintptr_t *address)
+{
+	int result = -ENODEV;
+	assert(is_valid_entity(handle) && (address != NULL));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->map != NULL)
+		result = dev->funcs->map(entity, length, address);
+
+	return result;
+}
+
+
 /* Write data to an IO entity */
 int io_write(uintptr_t handle,
 		const uintptr_t buffer,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -1003,11 +1003,20 @@
  * Definitions for system register interface to SPE
  ******************************************************************************/
 #define PMBLIMITR_EL1		S3_0_C9_C10_0
+#define PMBLIMITR_EL1_E_BIT	(ULL(1) << 0)
+
+/*******************************************************************************
+ * Definitions for system register interface to TRBE
+ ******************************************************************************/
+#define TRBLIMITR_EL1		S3_0_C9_C11_0
+#define TRBLIMITR_EL1_E_BIT	(ULL(1) << 0)
 
 /*******************************************************************************
  * Definitions for system register interface to MPAM
  ******************************************************************************/
 #define MPAMIDR_EL1		S3_0_C10_C4_4
+#define MPAM0_EL1		S3_0_C10_C5_1
+#define MPAM1_EL1		S3_0_C10_C5_0
 #define MPAM2_EL2		S3_4_C10_C5_0
 #define MPAMHCR_EL2		S3_4_C10_C4_0
 #define MPAM3_EL3		S3_6_C10_C5_0
@@ -1108,6 +1117,16 @@
 #define MPAM2_EL2_TRAPMPAM1EL1		(ULL(1) << 48)
 
 #define MPAMIDR_HAS_HCR_BIT		(ULL(1) << 17)
+#define MPAMIDR_PARTID_MAX_SHIFT	U(0)
+#define MPAMIDR_PARTID_MAX_MASK		ULL(0xffff)
+#define MPAMIDR_PMG_MAX_SHIFT		U(32)
+#define MPAMIDR_PMG_MAX_MASK		ULL(0xff)
+
+/* PARTID and PMG fields, common to MPAM0_EL1, MPAM1_EL1, MPAM2_EL2, MPAM3_EL3 */
+#define MPAMn_PARTID_I_SHIFT		U(0)
+#define MPAMn_PARTID_D_SHIFT		U(16)
+#define MPAMn_PMG_I_SHIFT		U(32)
+#define MPAMn_PMG_D_SHIFT		U(40)
 
 /*******************************************************************************
  * Definitions for system register interface to AMU for FEAT_AMUv1p1
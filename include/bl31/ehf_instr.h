@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EHF_INSTR_H
+#define EHF_INSTR_H
+
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+
+/*
+ * PMF timestamp IDs of the EHF instrumentation service.
+ *
+ * The first IDs hold the timestamps of the last EL3 interrupt handled by the
+ * CPU: entry into the EHF handler, acknowledgement at the interrupt controller
+ * and completion of the registered handler. GICv3 does not report when an
+ * interrupt was asserted, so the entry timestamp is the earliest point at which
+ * the interrupt is observed.
+ *
+ * EHF_INSTR_MAX_NS_MASKED holds the longest period, in counter ticks, during
+ * which Secure execution ran with Non-secure interrupts masked.
+ */
+#define EHF_INSTR_INTR_ENTRY		U(0)
+#define EHF_INSTR_INTR_ACK		U(1)
+#define EHF_INSTR_INTR_EXIT		U(2)
+#define EHF_INSTR_NS_MASK_START		U(3)
+#define EHF_INSTR_MAX_NS_MASKED		U(4)
+#define EHF_INSTR_PRI_BASE		U(5)
+
+/*
+ * Per priority level IDs, indexed by the EHF priority index:
+ *  - ACTIVATE:    timestamp of the last ehf_activate_priority() call.
+ *  - MAX_ACK:     longest delay between handler entry and acknowledgement.
+ *  - MAX_HANDLER: longest execution time of the registered handler.
+ *  - MAX_ACTIVE:  longest time the priority stayed explicitly activated.
+ * All durations are expressed in counter ticks.
+ */
+#define EHF_INSTR_PRI_ACTIVATE		U(0)
+#define EHF_INSTR_PRI_MAX_ACK		U(1)
+#define EHF_INSTR_PRI_MAX_HANDLER	U(2)
+#define EHF_INSTR_PRI_MAX_ACTIVE	U(3)
+#define EHF_INSTR_IDS_PER_PRI		U(4)
+
+/* EHF supports up to 32 priority levels, see ehf_pri_bits_t */
+#define EHF_INSTR_MAX_PRI		U(32)
+
+#define EHF_INSTR_PRI_ID(_idx, _id)	(EHF_INSTR_PRI_BASE + \
+					 ((_idx) * EHF_INSTR_IDS_PER_PRI) + (_id))
+
+#define EHF_INSTR_TOTAL_IDS		(EHF_INSTR_PRI_BASE + \
+					 (EHF_INSTR_MAX_PRI * EHF_INSTR_IDS_PER_PRI))
+
+#ifndef __ASSEMBLER__
+PMF_DECLARE_CAPTURE_TIMESTAMP(ehf_instr_svc)
+PMF_DECLARE_GET_TIMESTAMP(ehf_instr_svc)
+#endif /* __ASSEMBLER__ */
+
+#endif /* EHF_INSTR_H */
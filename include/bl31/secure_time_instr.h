@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SECURE_TIME_INSTR_H
+#define SECURE_TIME_INSTR_H
+
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+
+/*
+ * PMF timestamp IDs of the Secure time instrumentation service, recorded per
+ * CPU:
+ *  - ENTRY: timestamp of the current entry into the Secure world, or 0 while
+ *           the CPU executes in the Normal world.
+ *  - TOTAL: time spent in the Secure world, in counter ticks.
+ *  - COUNT: number of entries into the Secure world.
+ * The time is measured from the switch of context on the way into the Secure
+ * world to the switch back, so it includes the EL3 world switch overhead.
+ */
+#define SECURE_TIME_INSTR_ENTRY		U(0)
+#define SECURE_TIME_INSTR_TOTAL		U(1)
+#define SECURE_TIME_INSTR_COUNT		U(2)
+#define SECURE_TIME_INSTR_TOTAL_IDS	U(3)
+
+#ifndef __ASSEMBLER__
+PMF_DECLARE_CAPTURE_TIMESTAMP(secure_time_instr_svc)
+PMF_DECLARE_GET_TIMESTAMP(secure_time_instr_svc)
+#endif /* __ASSEMBLER__ */
+
+#endif /* SECURE_TIME_INSTR_H */
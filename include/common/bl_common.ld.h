@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -80,6 +80,16 @@
 #define BASE_XLAT_TABLE_BSS		BASE_XLAT_TABLE
 #endif
 
+/*
+ * Per call site statistics of the mmio_poll_timeout() helpers, only present
+ * when MMIO_POLL_STATS is enabled.
+ */
+#define MMIO_POLL_STATS					\
+	. = ALIGN(STRUCT_ALIGN);			\
+	__MMIO_POLL_STATS_START__ = .;			\
+	KEEP(*(mmio_poll_stats))			\
+	__MMIO_POLL_STATS_END__ = .;
+
 #define RODATA_COMMON					\
 	RT_SVC_DESCS					\
 	FCONF_POPULATOR					\
@@ -97,6 +107,7 @@
 #define DATA_SECTION					\
 	.data . : ALIGN(DATA_ALIGN) {			\
 		__DATA_START__ = .;			\
+		MMIO_POLL_STATS				\
 		*(SORT_BY_ALIGNMENT(.data*))		\
 		__DATA_END__ = .;			\
 	}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,9 +12,20 @@
 
 /* SMMUv3 register offsets from device base */
 #define SMMU_GBPA	U(0x0044)
+#define SMMU_S_IDR0	U(0x8000)
 #define SMMU_S_IDR1	U(0x8004)
+#define SMMU_S_CR0	U(0x8020)
+#define SMMU_S_CR0ACK	U(0x8024)
+#define SMMU_S_CR1	U(0x8028)
+#define SMMU_S_CR2	U(0x802c)
 #define SMMU_S_INIT	U(0x803c)
 #define SMMU_S_GBPA	U(0x8044)
+#define SMMU_S_GERROR	U(0x8060)
+#define SMMU_S_STRTAB_BASE	U(0x8080)
+#define SMMU_S_STRTAB_BASE_CFG	U(0x8088)
+#define SMMU_S_CMDQ_BASE	U(0x8090)
+#define SMMU_S_CMDQ_PROD	U(0x8098)
+#define SMMU_S_CMDQ_CONS	U(0x809c)
 
 /* SMMU_GBPA register fields */
 #define SMMU_GBPA_UPDATE		(1UL << 31)
@@ -22,6 +33,35 @@
 
 /* SMMU_S_IDR1 register fields */
 #define SMMU_S_IDR1_SECURE_IMPL		(1UL << 31)
+#define SMMU_S_IDR1_S_SIDSIZE_MASK	U(0x3f)
+
+/* SMMU_S_CR0 and SMMU_S_CR0ACK register fields */
+#define SMMU_S_CR0_SMMUEN		(1UL << 0)
+#define SMMU_S_CR0_CMDQEN		(1UL << 3)
+
+/*
+ * SMMU_S_CR1 register fields. Tables and queues are accessed as Inner
+ * Shareable, Write-Back cacheable memory.
+ */
+#define SMMU_S_CR1_QUEUE_IC_WB		(1UL << 0)
+#define SMMU_S_CR1_QUEUE_OC_WB		(1UL << 2)
+#define SMMU_S_CR1_QUEUE_SH_IS		(3UL << 4)
+#define SMMU_S_CR1_TABLE_IC_WB		(1UL << 6)
+#define SMMU_S_CR1_TABLE_OC_WB		(1UL << 8)
+#define SMMU_S_CR1_TABLE_SH_IS		(3UL << 10)
+
+/* SMMU_S_CR2 register fields */
+#define SMMU_S_CR2_RECINVSID		(1UL << 1)
+#define SMMU_S_CR2_PTM			(1UL << 2)
+
+/* SMMU_S_STRTAB_BASE and SMMU_S_CMDQ_BASE register fields */
+#define SMMU_S_BASE_RA			(1ULL << 62)
+#define SMMU_S_STRTAB_BASE_ADDR_MASK	ULL(0x000fffffffffffc0)
+#define SMMU_S_CMDQ_BASE_ADDR_MASK	ULL(0x000fffffffffffe0)
+
+/* SMMU_S_CMDQ_CONS register fields */
+#define SMMU_S_CMDQ_CONS_ERR_SHIFT	U(24)
+#define SMMU_S_CMDQ_CONS_ERR_MASK	U(0x7f)
 
 /* SMMU_S_INIT register fields */
 #define SMMU_S_INIT_INV_ALL		(1UL << 0)
@@ -30,7 +70,49 @@
 #define SMMU_S_GBPA_UPDATE		(1UL << 31)
 #define SMMU_S_GBPA_ABORT		(1UL << 20)
 
+struct xlat_ctx;
+
+/* Stream table entry and context descriptor sizes */
+#define SMMU_STE_SIZE			U(64)
+#define SMMU_CD_SIZE			U(64)
+#define SMMU_CMD_SIZE			U(16)
+
+/* Maximum number of commands submitted by smmuv3_s_cmdq_submit() */
+#define SMMU_CMDQ_MAX_BATCH		U(16)
+
+/* SMMUv3 command, as written in the command queue */
+typedef struct smmuv3_cmd {
+	uint64_t dw[2];
+} smmuv3_cmd_t;
+
+/*
+ * Secure state configuration of an SMMUv3. The stream table and the command
+ * queue are provided by the platform, in Secure memory mapped as cacheable
+ * by EL3:
+ *  - strtab_base: linear stream table of (1 << strtab_log2size) entries of
+ *    SMMU_STE_SIZE bytes, aligned to its size;
+ *  - cmdq_base: command queue of (1 << cmdq_log2size) entries of
+ *    SMMU_CMD_SIZE bytes, aligned to its size and to at least 32 bytes.
+ */
+typedef struct smmuv3_s_config {
+	uintptr_t smmu_base;
+	uintptr_t strtab_base;
+	unsigned int strtab_log2size;
+	uintptr_t cmdq_base;
+	unsigned int cmdq_log2size;
+} smmuv3_s_config_t;
+
 int smmuv3_init(uintptr_t smmu_base);
 int smmuv3_security_init(uintptr_t smmu_base);
 
+int smmuv3_s_setup(const smmuv3_s_config_t *config);
+int smmuv3_s_cmdq_submit(const smmuv3_s_config_t *config,
+			 const smmuv3_cmd_t *cmds, unsigned int num);
+int smmuv3_s_ste_abort(const smmuv3_s_config_t *config, uint32_t sid);
+int smmuv3_s_ste_bypass(const smmuv3_s_config_t *config, uint32_t sid);
+int smmuv3_s_ste_xlat(const smmuv3_s_config_t *config, uint32_t sid,
+		      uintptr_t cd_base, uint16_t asid,
+		      const struct xlat_ctx *ctx);
+int smmuv3_s_tlbi_asid(const smmuv3_s_config_t *config, uint16_t asid);
+
 #endif /* SMMU_V3_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -99,6 +99,8 @@ typedef struct tzc_dmc620_config_data {
 
 /* Function prototypes */
 void arm_tzc_dmc620_setup(const tzc_dmc620_config_data_t *plat_config_data);
+void tzc_dmc620_telemetry_init(
+			const tzc_dmc620_config_data_t *plat_config_data);
 
 #endif /* TZC_DMC620_H */
 
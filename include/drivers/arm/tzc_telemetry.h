@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TZC_TELEMETRY_H
+#define TZC_TELEMETRY_H
+
+#include <lib/smccc.h>
+#include <lib/utils_def.h>
+
+/*
+ * The telemetry is only kept by BL31, which handles the failed access
+ * interrupt at runtime. Earlier images program the controller as usual.
+ */
+#if TZC_TELEMETRY && defined(IMAGE_BL31)
+#define TZC_TELEMETRY_ENABLED		1
+#else
+#define TZC_TELEMETRY_ENABLED		0
+#endif
+
+/*
+ * TZC telemetry SiP SMC function IDs
+ * 0x82000060-0x8200006F
+ */
+#define TZC_TELEMETRY_FNUM_GET_STATS	U(0x60)
+#define TZC_TELEMETRY_FNUM_GET_REGION	U(0x61)
+#define TZC_TELEMETRY_FNUM_GET_FAULT	U(0x62)
+#define TZC_TELEMETRY_FNUM_REARM	U(0x63)
+/* 0x64-0x6F reserved for future use */
+
+#define TZC_TELEMETRY_FID(func_num)	(U(0x82000000) | (func_num))
+#define TZC_TELEMETRY_GET_STATS		TZC_TELEMETRY_FID(TZC_TELEMETRY_FNUM_GET_STATS)
+#define TZC_TELEMETRY_GET_REGION	TZC_TELEMETRY_FID(TZC_TELEMETRY_FNUM_GET_REGION)
+#define TZC_TELEMETRY_GET_FAULT		TZC_TELEMETRY_FID(TZC_TELEMETRY_FNUM_GET_FAULT)
+#define TZC_TELEMETRY_REARM		TZC_TELEMETRY_FID(TZC_TELEMETRY_FNUM_REARM)
+
+#define TZC_TELEMETRY_NUM_SMC_CALLS	4
+
+/* Macro to identify function calls */
+#define TZC_TELEMETRY_FID_MASK		U(0xFFFFFFF0)
+#define TZC_TELEMETRY_FID_VALUE		TZC_TELEMETRY_FID(U(0x60))
+#define is_tzc_telemetry_fid(_fid)	\
+	(((_fid) & TZC_TELEMETRY_FID_MASK) == TZC_TELEMETRY_FID_VALUE)
+
+/* Return codes of the SMC calls */
+#define TZC_TELEMETRY_SUCCESS		0
+#define TZC_TELEMETRY_INVALID_PARAM	-2
+#define TZC_TELEMETRY_NO_DATA		-3
+
+/* Flags describing a failed access */
+#define TZC_FAULT_NS			BIT_32(0)
+#define TZC_FAULT_PRIV			BIT_32(1)
+#define TZC_FAULT_WRITE			BIT_32(2)
+
+/*
+ * Limits of the telemetry counters. DMC-500 faults are reported per DMC
+ * instance and system interface, which are accounted as separate filters.
+ */
+#define TZC_TELEMETRY_MAX_FILTERS	U(8)
+#define TZC_TELEMETRY_MAX_REGIONS	U(9)
+
+/* Region value reported when a fault does not hit a configured region */
+#define TZC_TELEMETRY_NO_REGION		U(0xff)
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Description of a failed access, as recorded in the fault ring */
+typedef struct tzc_fault {
+	uint64_t address;
+	uint64_t timestamp;
+	uint32_t fail_id;
+	uint8_t filter;
+	uint8_t region;
+	uint16_t flags;
+} tzc_fault_t;
+
+/*
+ * Callback provided by the controller driver to enable or disable its
+ * failed access interrupt, used to rate limit fault storms.
+ */
+typedef void (*tzc_telemetry_set_int_t)(bool enable);
+
+void tzc_telemetry_init(tzc_telemetry_set_int_t set_int);
+void tzc_telemetry_set_region(unsigned int region,
+			      unsigned long long region_base,
+			      unsigned long long region_top,
+			      unsigned int filters);
+void tzc_telemetry_update_filters(unsigned int region, unsigned int filters);
+void tzc_telemetry_record(tzc_fault_t *fault);
+int tzc_telemetry_get_fault(unsigned int index, tzc_fault_t *fault);
+uint32_t tzc_telemetry_filter_faults(unsigned int filter);
+uint32_t tzc_telemetry_region_faults(unsigned int region);
+uint32_t tzc_telemetry_total_faults(void);
+uint32_t tzc_telemetry_throttle_count(void);
+void tzc_telemetry_rearm(void);
+
+uintptr_t tzc_telemetry_smc_handler(uint32_t smc_fid,
+				    u_register_t x1,
+				    u_register_t x2,
+				    u_register_t x3,
+				    u_register_t x4,
+				    void *cookie,
+				    void *handle,
+				    u_register_t flags);
+
+#endif /* __ASSEMBLER__ */
+#endif /* TZC_TELEMETRY_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -47,11 +47,11 @@ typedef struct crypto_lib_desc_s {
 	int (*verify_hash)(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
 
-#if MEASURED_BOOT
+#if MEASURED_BOOT || OPTEE_PAGEABLE_HASHES
 	/* Calculate a hash. Return hash value */
 	int (*calc_hash)(unsigned int alg, void *data_ptr,
 			 unsigned int data_len, unsigned char *output);
-#endif /* MEASURED_BOOT */
+#endif /* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
 
 	/*
 	 * Authenticated decryption. Return one of the
@@ -78,7 +78,7 @@ int crypto_mod_auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 			    unsigned int iv_len, const void *tag,
 			    unsigned int tag_len);
 
-#if MEASURED_BOOT
+#if MEASURED_BOOT || OPTEE_PAGEABLE_HASHES
 int crypto_mod_calc_hash(unsigned int alg, void *data_ptr,
 			 unsigned int data_len, unsigned char *output);
 
@@ -103,8 +103,54 @@ int crypto_mod_calc_hash(unsigned int alg, void *data_ptr,
 		.verify_hash = _verify_hash, \
 		.auth_decrypt = _auth_decrypt \
 	}
-#endif	/* MEASURED_BOOT */
+#endif	/* MEASURED_BOOT || OPTEE_PAGEABLE_HASHES */
 
 extern const crypto_lib_desc_t crypto_lib_desc;
 
+#if BL1_FWU_STREAM_HASH
+/*
+ * Incremental hash calculation, using the hash algorithm the library has been
+ * configured with. Only one calculation can be in progress at a time.
+ */
+typedef struct crypto_hash_stream_desc_s {
+	/* Start a new calculation, discarding any calculation in progress */
+	int (*start)(void);
+
+	/* Add data to the calculation in progress */
+	int (*update)(const void *data_ptr, unsigned int data_len);
+
+	/*
+	 * Complete the calculation in progress. 'output' must be able to hold
+	 * CRYPTO_MAX_HASH_SIZE bytes, '*output_len' is set to the hash size.
+	 */
+	int (*finish)(unsigned char *output, unsigned int *output_len);
+
+	/* Compare a hash calculated above with a DER encoded DigestInfo */
+	int (*verify)(const unsigned char *hash_ptr, unsigned int hash_len,
+		      void *digest_info_ptr, unsigned int digest_info_len);
+} crypto_hash_stream_desc_t;
+
+#define CRYPTO_MAX_HASH_SIZE		64U
+
+int crypto_mod_hash_stream_start(void);
+int crypto_mod_hash_stream_update(const void *data_ptr, unsigned int data_len);
+int crypto_mod_hash_stream_finish(unsigned char *output,
+				  unsigned int *output_len);
+int crypto_mod_hash_stream_verify(const unsigned char *hash_ptr,
+				  unsigned int hash_len,
+				  void *digest_info_ptr,
+				  unsigned int digest_info_len);
+
+/* Macro to register the incremental hash functions of a library */
+#define REGISTER_CRYPTO_HASH_STREAM(_start, _update, _finish, _verify) \
+	const crypto_hash_stream_desc_t crypto_hash_stream_desc = { \
+		.start = _start, \
+		.update = _update, \
+		.finish = _finish, \
+		.verify = _verify \
+	}
+
+extern const crypto_hash_stream_desc_t crypto_hash_stream_desc;
+#endif /* BL1_FWU_STREAM_HASH */
+
 #endif /* CRYPTO_MOD_H */
@@ -1,10 +1,10 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  * FWU metadata information as per the specification section 4.1:
- * https://developer.arm.com/documentation/den0118/a/
+ * https://developer.arm.com/documentation/den0118/b/
  *
  */
 
@@ -14,11 +14,22 @@
 #include <stdint.h>
 #include <tools_share/uuid.h>
 
+/* Version of the FWU metadata format */
+#define FWU_METADATA_VERSION		2U
+
+/* Maximum number of banks described by the FWU metadata bank_state array */
+#define FWU_METADATA_MAX_BANKS		4U
+
+/* Bank states */
+#define FWU_BANK_STATE_ACCEPTED		0xFCU
+#define FWU_BANK_STATE_VALID		0xFEU
+#define FWU_BANK_STATE_INVALID		0xFFU
+
 /* Properties of image in a bank */
-struct fwu_image_properties {
+struct fwu_image_bank_info {
 
-	/* UUID of the image in this bank */
-	uuid_t img_uuid;
+	/* GUID of the image in this bank */
+	uuid_t img_guid;
 
 	/* [0]: bit describing the image acceptance status –
 	 *      1 means the image is accepted
@@ -34,14 +45,37 @@ struct fwu_image_properties {
 /* Image entry information */
 struct fwu_image_entry {
 
-	/* UUID identifying the image type */
-	uuid_t img_type_uuid;
+	/* GUID identifying the image type */
+	uuid_t img_type_guid;
 
-	/* UUID of the storage volume where the image is located */
-	uuid_t location_uuid;
+	/* GUID of the storage volume where the image is located */
+	uuid_t location_guid;
 
-	/* Properties of images with img_type_uuid in the different FW banks */
-	struct fwu_image_properties img_props[NR_OF_FW_BANKS];
+	/* Properties of images with img_type_guid in the different FW banks */
+	struct fwu_image_bank_info img_bank_info[NR_OF_FW_BANKS];
+
+} __packed;
+
+/* Firmware store descriptor */
+struct fwu_fw_store_desc {
+
+	/* Number of banks */
+	uint8_t num_banks;
+
+	/* Reserved (MBZ) */
+	uint8_t reserved;
+
+	/* Number of images per bank */
+	uint16_t num_images;
+
+	/* Size of an image entry */
+	uint16_t img_entry_size;
+
+	/* Size of an image bank info structure */
+	uint16_t bank_info_entry_size;
+
+	/* Image entry information */
+	struct fwu_image_entry img_entry[NR_OF_IMAGES_IN_FW_BANK];
 
 } __packed;
 
@@ -66,8 +100,23 @@ struct fwu_metadata {
 	/* Previous bank index with which device booted successfully */
 	uint32_t previous_active_index;
 
-	/* Image entry information */
-	struct fwu_image_entry img_entry[NR_OF_IMAGES_IN_FW_BANK];
+	/* Size of the entire metadata in bytes */
+	uint32_t metadata_size;
+
+	/* Offset of the firmware store descriptor */
+	uint16_t desc_offset;
+
+	/* Reserved (MBZ) */
+	uint16_t reserved1;
+
+	/* Bank states, one of FWU_BANK_STATE_* */
+	uint8_t bank_state[FWU_METADATA_MAX_BANKS];
+
+	/* Reserved (MBZ) */
+	uint32_t reserved2;
+
+	/* Firmware store descriptor */
+	struct fwu_fw_store_desc fw_desc;
 
 } __packed;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -45,6 +45,15 @@ typedef struct io_dev_funcs {
 			size_t *length_read);
 	int (*write)(io_entity_t *entity, const uintptr_t buffer,
 			size_t length, size_t *length_written);
+	/*
+	 * Optional: return the address at which the next 'length' bytes of the
+	 * entity can be read directly, without moving the file position. Only
+	 * provided by devices whose content is memory-mapped. The memory may
+	 * still be writable by other agents: callers must not check its content
+	 * and then use it again from this address, but copy it to a location
+	 * they trust first.
+	 */
+	int (*map)(io_entity_t *entity, size_t length, uintptr_t *address);
 	int (*close)(io_entity_t *entity);
 	int (*dev_init)(io_dev_info_t *dev_info, const uintptr_t init_params);
 	int (*dev_close)(io_dev_info_t *dev_info);
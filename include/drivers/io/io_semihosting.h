@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,5 +10,6 @@
 struct io_dev_connector;
 
 int register_io_dev_sh(const struct io_dev_connector **dev_con);
+void io_sh_print_stats(void);
 
 #endif /* IO_SEMIHOSTING_H */
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MMIO_POLL_H
+#define MMIO_POLL_H
+
+#include <cdefs.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch.h>
+#include <arch_helpers.h>
+#include <drivers/delay_timer.h>
+#include <lib/mmio.h>
+
+/*******************************************************************************
+ * Register polling helpers.
+ *
+ * mmio_poll_timeout_32() and mmio_poll_timeout_64() read a register until
+ * (value & mask) == expected, or until 'timeout_us' microseconds have elapsed
+ * on the generic timer. They return 0 on success and -ETIMEDOUT otherwise. The
+ * register is always read once more after the timeout has been observed, so a
+ * poll that got preempted past its deadline does not report a spurious
+ * timeout. The _val variants also return the last value read.
+ *
+ * With MMIO_POLL_WFE=1 the CPU waits in WFE between reads. CNTKCTL_EL1 is
+ * temporarily programmed to generate an event stream with a period close to a
+ * microsecond, which bounds the wait, and is restored once the poll completes.
+ *
+ * With MMIO_POLL_STATS=1 every call site records the number of polls, the
+ * number of timeouts and the total and longest time spent polling, in counter
+ * ticks. The records are not protected against concurrent updates from several
+ * CPUs and must be treated as approximate. They can be printed using
+ * mmio_poll_stats_dump().
+ ******************************************************************************/
+
+typedef struct mmio_poll_stats {
+	const char *func;
+	unsigned int line;
+	uint32_t calls;
+	uint32_t timeouts;
+	uint64_t total_ticks;
+	uint64_t max_ticks;
+} mmio_poll_stats_t;
+
+#if MMIO_POLL_STATS
+#define MMIO_POLL_SITE() __extension__ ({				\
+	static mmio_poll_stats_t __section("mmio_poll_stats") __used	\
+		mmio_poll_site = {					\
+			.func = __func__, .line = __LINE__		\
+		};							\
+	&mmio_poll_site;						\
+})
+
+void mmio_poll_stats_dump(void);
+#else
+#define MMIO_POLL_SITE()	NULL
+
+static inline void mmio_poll_stats_dump(void)
+{
+}
+#endif /* MMIO_POLL_STATS */
+
+#if MMIO_POLL_WFE
+/* Event stream trigger bit giving a period of at most one microsecond */
+static inline u_register_t mmio_poll_evnti(void)
+{
+	uint64_t ticks_per_us = timeout_cnt_us2cnt(1U);
+	u_register_t evnti = 0U;
+
+	/* The event stream period is 2^(EVNTI + 1) ticks */
+	while ((evnti < EVNTI_MASK) && ((4ULL << evnti) <= ticks_per_us)) {
+		evnti++;
+	}
+
+	return evnti;
+}
+
+static inline u_register_t mmio_poll_wait_enter(void)
+{
+	u_register_t cntkctl = read_cntkctl_el1();
+
+	write_cntkctl_el1((cntkctl & ~(EVNTDIR_BIT |
+				       (EVNTI_MASK << EVNTI_SHIFT))) |
+			  EVNTEN_BIT | (mmio_poll_evnti() << EVNTI_SHIFT));
+	isb();
+
+	return cntkctl;
+}
+
+static inline void mmio_poll_wait(void)
+{
+	wfe();
+}
+
+static inline void mmio_poll_wait_exit(u_register_t cntkctl)
+{
+	write_cntkctl_el1(cntkctl);
+	isb();
+}
+#else
+static inline u_register_t mmio_poll_wait_enter(void)
+{
+	return 0U;
+}
+
+static inline void mmio_poll_wait(void)
+{
+}
+
+static inline void mmio_poll_wait_exit(u_register_t cntkctl)
+{
+}
+#endif /* MMIO_POLL_WFE */
+
+static inline void mmio_poll_record(mmio_poll_stats_t *site, uint64_t start,
+				    int ret)
+{
+	uint64_t ticks;
+
+	if (site == NULL) {
+		return;
+	}
+
+	ticks = read_cntpct_el0() - start;
+
+	site->calls++;
+	site->total_ticks += ticks;
+	if (ticks > site->max_ticks) {
+		site->max_ticks = ticks;
+	}
+	if (ret != 0) {
+		site->timeouts++;
+	}
+}
+
+static inline int mmio_poll_timeout(uintptr_t addr, uint64_t mask,
+				    uint64_t expected, uint32_t timeout_us,
+				    bool is_64, uint64_t *val,
+				    mmio_poll_stats_t *site)
+{
+	uint64_t start = read_cntpct_el0();
+	uint64_t expire = start + timeout_cnt_us2cnt(timeout_us);
+	u_register_t cntkctl;
+	uint64_t reg;
+	bool expired;
+	int ret;
+
+	/* Avoid touching the timer configuration when no wait is needed */
+	reg = is_64 ? mmio_read_64(addr) : mmio_read_32(addr);
+	if ((reg & mask) == expected) {
+		ret = 0;
+		goto out;
+	}
+
+	cntkctl = mmio_poll_wait_enter();
+	do {
+		mmio_poll_wait();
+
+		expired = timeout_elapsed(expire);
+		reg = is_64 ? mmio_read_64(addr) : mmio_read_32(addr);
+		ret = ((reg & mask) == expected) ? 0 : -ETIMEDOUT;
+	} while ((ret != 0) && !expired);
+	mmio_poll_wait_exit(cntkctl);
+
+out:
+	if (val != NULL) {
+		*val = reg;
+	}
+
+	mmio_poll_record(site, start, ret);
+
+	return ret;
+}
+
+static inline int mmio_poll_timeout_32_site(uintptr_t addr, uint32_t mask,
+					    uint32_t expected,
+					    uint32_t timeout_us, uint32_t *val,
+					    mmio_poll_stats_t *site)
+{
+	uint64_t reg;
+	int ret;
+
+	ret = mmio_poll_timeout(addr, mask, expected, timeout_us, false, &reg,
+				site);
+	if (val != NULL) {
+		*val = (uint32_t)reg;
+	}
+
+	return ret;
+}
+
+#define mmio_poll_timeout_32_val(addr, mask, expected, timeout_us, val)	\
+	mmio_poll_timeout_32_site((addr), (mask), (expected), (timeout_us), \
+				  (val), MMIO_POLL_SITE())
+
+#define mmio_poll_timeout_32(addr, mask, expected, timeout_us)		\
+	mmio_poll_timeout_32_val((addr), (mask), (expected), (timeout_us), \
+				 NULL)
+
+#define mmio_poll_timeout_64_val(addr, mask, expected, timeout_us, val)	\
+	mmio_poll_timeout((addr), (mask), (expected), (timeout_us), true, \
+			  (val), MMIO_POLL_SITE())
+
+#define mmio_poll_timeout_64(addr, mask, expected, timeout_us)		\
+	mmio_poll_timeout_64_val((addr), (mask), (expected), (timeout_us), \
+				 NULL)
+
+#endif /* MMIO_POLL_H */
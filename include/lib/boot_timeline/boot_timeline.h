@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <lib/utils_def.h>
+
+/*
+ * Each boot timeline event is identified by the stage that recorded it, the
+ * phase of the boot being timed and, for image related phases, the image id.
+ */
+#define BOOT_TL_STAGE_SHIFT		U(24)
+#define BOOT_TL_STAGE_MASK		U(0xff)
+#define BOOT_TL_PHASE_SHIFT		U(16)
+#define BOOT_TL_PHASE_MASK		U(0xff)
+#define BOOT_TL_IMAGE_SHIFT		U(0)
+#define BOOT_TL_IMAGE_MASK		U(0xffff)
+
+#define BOOT_TL_EVENT_ID(_stage, _phase, _image)			\
+	((((_stage) & BOOT_TL_STAGE_MASK) << BOOT_TL_STAGE_SHIFT) |	\
+	 (((_phase) & BOOT_TL_PHASE_MASK) << BOOT_TL_PHASE_SHIFT) |	\
+	 (((_image) & BOOT_TL_IMAGE_MASK) << BOOT_TL_IMAGE_SHIFT))
+
+/* Boot stages */
+#define BOOT_TL_STAGE_BL1		U(1)
+#define BOOT_TL_STAGE_BL2		U(2)
+#define BOOT_TL_STAGE_BL31		U(3)
+
+/* Phases timed within a stage */
+#define BOOT_TL_PHASE_STAGE		U(0)	/* Stage entry to exit */
+#define BOOT_TL_PHASE_LOAD		U(1)	/* Image load, open to close */
+#define BOOT_TL_PHASE_COPY		U(2)	/* Image read from its source */
+#define BOOT_TL_PHASE_HASH		U(3)	/* Image hash verification */
+#define BOOT_TL_PHASE_SIGNATURE		U(4)	/* Image signature verification */
+
+/* Image id of the events that are not related to an image */
+#define BOOT_TL_NO_IMAGE		U(0xffff)
+
+/* Value returned by boot_timeline_begin() when the buffer is full */
+#define BOOT_TL_INVALID_EVENT		U(0xffffffff)
+
+#define BOOT_TL_MAGIC			U(0x4c544254)	/* "TBTL" */
+#define BOOT_TL_VERSION			U(1)
+
+/*
+ * PMF timestamp ids of the boot timeline service. For each recorded event n,
+ * the id of the event and its start and end counter values are returned by
+ * timestamp ids BOOT_TL_PMF_EVENT_ID(n) to BOOT_TL_PMF_EVENT_ID(n) + 2.
+ */
+#define BOOT_TL_PMF_NUM_EVENTS		U(0)
+#define BOOT_TL_PMF_CNTFRQ		U(1)
+#define BOOT_TL_PMF_EVENT_ID(_n)	(U(2) + (U(3) * (_n)))
+#define BOOT_TL_PMF_TOTAL_IDS		U(255)
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+/*
+ * Layout of the boot timeline buffer shared by the boot stages. The start and
+ * end of each event are values of the system counter, which keeps counting
+ * across the stage transitions.
+ */
+typedef struct boot_timeline_event {
+	uint32_t id;
+	uint32_t reserved;
+	uint64_t start;
+	uint64_t end;
+} boot_timeline_event_t;
+
+typedef struct boot_timeline {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t max_events;
+	uint32_t num_events;
+	uint32_t dropped_events;
+	uint32_t reserved;
+	uint64_t cntfrq;
+	boot_timeline_event_t events[];
+} boot_timeline_t;
+
+#if ENABLE_BOOT_TIMELINE
+void boot_timeline_init(void);
+unsigned int boot_timeline_begin(unsigned int phase, unsigned int image_id);
+void boot_timeline_end(unsigned int event);
+void boot_timeline_flush(void);
+void boot_timeline_print(void);
+#else
+static inline void boot_timeline_init(void)
+{
+}
+
+static inline unsigned int boot_timeline_begin(unsigned int phase,
+					       unsigned int image_id)
+{
+	return BOOT_TL_INVALID_EVENT;
+}
+
+static inline void boot_timeline_end(unsigned int event)
+{
+}
+
+static inline void boot_timeline_flush(void)
+{
+}
+
+static inline void boot_timeline_print(void)
+{
+}
+#endif /* ENABLE_BOOT_TIMELINE */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* BOOT_TIMELINE_H */
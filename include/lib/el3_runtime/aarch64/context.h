@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -138,10 +138,23 @@
 #define CTX_MTE_REGS_END	CTX_TIMER_SYSREGS_END
 #endif /* CTX_INCLUDE_MTE_REGS */
 
+/*
+ * The MPAM0_EL1 and MPAM1_EL1 registers select the PARTID and PMG of each
+ * world, they only need to be switched when a PARTID is assigned to the
+ * secure world.
+ */
+#if MPAM_PARTITIONING
+#define CTX_MPAM0_EL1		(CTX_MTE_REGS_END + U(0x0))
+#define CTX_MPAM1_EL1		(CTX_MTE_REGS_END + U(0x8))
+#define CTX_MPAM_REGS_END	(CTX_MTE_REGS_END + U(0x10))
+#else
+#define CTX_MPAM_REGS_END	CTX_MTE_REGS_END
+#endif /* MPAM_PARTITIONING */
+
 /*
  * End of system registers.
  */
-#define CTX_EL1_SYSREGS_END		CTX_MTE_REGS_END
+#define CTX_EL1_SYSREGS_END		CTX_MPAM_REGS_END
 
 /*
  * EL2 register set
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2022, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CHIP_LOCAL_PERCPU_H
+#define CHIP_LOCAL_PERCPU_H
+
+#include <platform_def.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Size of an entry in the platform chip-local region table. Used by the
+ * assembly implementation of _cpu_data_by_index() to index the table.
+ */
+#define CHIP_LOCAL_REGION_SHIFT		U(4)
+
+#ifndef __ASSEMBLER__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <context.h>
+#include <lib/cassert.h>
+#include <lib/el3_runtime/cpu_data.h>
+
+/*******************************************************************************
+ * Multichip platforms can ask for the per-cpu EL3 data of each chip's CPUs to
+ * be placed in a memory region local to that chip, so that the SMC and PSCI
+ * paths of a core do not cross the chip-to-chip link. CPU linear indices are
+ * assumed to be allocated chip by chip, PLAT_CHIP_CORE_COUNT per chip.
+ *
+ * Each chip-local region is laid out as follows, every structure being
+ * aligned and sized to CACHE_WRITEBACK_GRANULE so that no cache line is
+ * shared between two CPUs:
+ *
+ *   base -> cpu_data_t      [PLAT_CHIP_CORE_COUNT]
+ *           cpu_context_t   [PLAT_CHIP_CORE_COUNT]  (Non-secure contexts)
+ *
+ * The platform describes the regions through 'plat_chip_local_percpu_regions'.
+ * They must be mapped as normal cacheable memory by the time
+ * bl31_plat_arch_setup() returns.
+ ******************************************************************************/
+typedef struct chip_local_region {
+	uintptr_t base;
+	size_t size;
+} chip_local_region_t;
+
+CASSERT(sizeof(chip_local_region_t) == (1U << CHIP_LOCAL_REGION_SHIFT),
+	assert_chip_local_region_size_mismatch);
+
+CASSERT(PLATFORM_CORE_COUNT == (PLAT_CHIP_COUNT * PLAT_CHIP_CORE_COUNT),
+	assert_chip_local_core_count_mismatch);
+
+/* Size of a per-cpu context slot, rounded up to the cache line size */
+#define CHIP_LOCAL_CTX_SLOT_SIZE	round_up(sizeof(cpu_context_t), \
+						 CACHE_WRITEBACK_GRANULE)
+
+/* Offset of the per-cpu context array within a chip-local region */
+#define CHIP_LOCAL_CTX_OFFSET		(CPU_DATA_SIZE * PLAT_CHIP_CORE_COUNT)
+
+/* Minimum size of a chip-local region */
+#define CHIP_LOCAL_REGION_MIN_SIZE	(CHIP_LOCAL_CTX_OFFSET + \
+					 (CHIP_LOCAL_CTX_SLOT_SIZE * \
+					  PLAT_CHIP_CORE_COUNT))
+
+/* Region table provided by the platform */
+extern const chip_local_region_t plat_chip_local_percpu_regions[PLAT_CHIP_COUNT];
+
+/*******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+void chip_local_percpu_init(void);
+cpu_context_t *chip_local_ns_context_by_index(unsigned int cpu_idx);
+
+static inline unsigned int chip_local_chip_id(unsigned int cpu_idx)
+{
+	return cpu_idx / PLAT_CHIP_CORE_COUNT;
+}
+
+#endif /* __ASSEMBLER__ */
+#endif /* CHIP_LOCAL_PERCPU_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -139,7 +139,9 @@ typedef struct cpu_data {
 #endif
 } __aligned(CACHE_WRITEBACK_GRANULE) cpu_data_t;
 
+#if !CHIP_LOCAL_PERCPU_DATA
 extern cpu_data_t percpu_data[PLATFORM_CORE_COUNT];
+#endif
 
 #ifdef __aarch64__
 CASSERT(CPU_DATA_CONTEXT_NUM == CPU_CONTEXT_NUM,
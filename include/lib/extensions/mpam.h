@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,7 +8,66 @@
 #define MPAM_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include <context.h>
+
+/* PARTID and PMG assigned to the traffic of an exception level or world */
+typedef struct mpam_partid_cfg {
+	uint16_t partid;
+	uint8_t pmg;
+} mpam_partid_cfg_t;
+
+/*
+ * Partition settings programmed into a memory-system component (MSC) for a
+ * PARTID. 'ns' selects whether 'partid' belongs to the Non-secure or to the
+ * Secure PARTID space.
+ *
+ * 'cpbm' is the cache portion bitmap of the partition; portions beyond the
+ * first 64 are not allocated to it. 'mbw_min' and 'mbw_max' are the minimum
+ * and maximum memory bandwidth of the partition, as fixed-point fractions of
+ * the available bandwidth with the binary point to the left of bit 15. A zero
+ * field leaves the corresponding control at its reset value.
+ */
+typedef struct mpam_msc_part_cfg {
+	uint16_t partid;
+	bool ns;
+	uint64_t cpbm;
+	uint16_t mbw_min;
+	uint16_t mbw_max;
+} mpam_msc_part_cfg_t;
+
+/*
+ * Description of an MSC: base address of its Secure and Non-secure MPAM
+ * feature pages and partition settings to program at boot.
+ */
+typedef struct mpam_msc_desc {
+	uintptr_t s_base;
+	uintptr_t ns_base;
+	const mpam_msc_part_cfg_t *parts;
+	unsigned int num_parts;
+} mpam_msc_desc_t;
+
+/* MPAM configuration provided by the platform */
+typedef struct mpam_plat_config {
+	/* PARTID and PMG of the EL3 firmware traffic */
+	mpam_partid_cfg_t el3;
+
+	/* PARTID and PMG of the Secure world traffic */
+	mpam_partid_cfg_t secure;
+
+	/* MSCs to program at boot */
+	const mpam_msc_desc_t *msc;
+	unsigned int num_msc;
+} mpam_plat_config_t;
 
 void mpam_enable(bool el2_unused);
 
+#if MPAM_PARTITIONING
+void mpam_init_secure_context(cpu_context_t *ctx);
+void mpam_msc_init(void);
+
+const mpam_plat_config_t *plat_mpam_get_config(void);
+#endif
+
 #endif /* MPAM_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +8,7 @@
 #define OPTEE_UTILS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <common/bl_common.h>
 
@@ -17,4 +18,30 @@ int parse_optee_header(entry_point_info_t *header_ep,
 	image_info_t *pager_image_info,
 	image_info_t *paged_image_info);
 
+#if OPTEE_PAGEABLE_HASHES
+/*
+ * Table of the SHA-256 hashes of the pages of the OP-TEE pageable image,
+ * placed by BL2 right after the image and passed to OP-TEE in x3. The hash of
+ * page n starts at hashes[n * hash_len].
+ */
+#define OPTEE_PAGEABLE_HASHES_MAGIC	U(0x48474150)	/* "PAGH" */
+#define OPTEE_PAGEABLE_HASHES_VERSION	U(1)
+#define OPTEE_PAGEABLE_PAGE_SIZE	U(0x1000)
+#define OPTEE_PAGEABLE_HASH_SIZE	U(32)
+
+typedef struct optee_pageable_hashes {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t base;
+	uint32_t page_size;
+	uint32_t num_pages;
+	uint32_t hash_len;
+	uint32_t reserved;
+	uint8_t hashes[];
+} optee_pageable_hashes_t;
+
+int optee_hash_pageable(entry_point_info_t *header_ep,
+			const image_info_t *paged_image_info);
+#endif /* OPTEE_PAGEABLE_HASHES */
+
 #endif /* OPTEE_UTILS_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2014, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -25,6 +25,9 @@
 #define SEMIHOSTING_SYS_ERRNO           0x13
 #define SEMIHOSTING_SYS_EXIT            0x18
 
+/* Operation value used to get the total number of traps */
+#define SEMIHOSTING_SYS_ALL		(~0UL)
+
 #define FOPEN_MODE_R			0x0
 #define FOPEN_MODE_RB			0x1
 #define FOPEN_MODE_RPLUS		0x2
@@ -56,5 +59,6 @@ void semihosting_write_char(char character);
 void semihosting_write_string(char *string);
 char semihosting_read_char(void);
 void semihosting_exit(uint32_t reason, uint32_t subcode);
+unsigned int semihosting_get_trap_count(unsigned long operation);
 
 #endif /* SEMIHOSTING_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2019,2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2019,2021-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -31,6 +31,15 @@
  * 0x82000050-0x8200005F
  */
 
+/*
+ * TZC telemetry SiP SMC function IDs
+ * 0x82000060-0x8200006F
+ */
+
+/* SMC_PCI_RW_BATCH			0x82000080 */
+
+/* SDEI_EVENT_CONTEXT_BUFFER		0xC2000090 */
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		U(0x0)
 #define ARM_SIP_SVC_VERSION_MINOR		U(0x2)
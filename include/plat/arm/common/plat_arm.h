@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -174,6 +174,7 @@ void arm_tzc400_setup(uintptr_t tzc_base,
 struct tzc_dmc500_driver_data;
 void arm_tzc_dmc500_setup(struct tzc_dmc500_driver_data *plat_driver_data,
 			const arm_tzc_regions_info_t *tzc_regions);
+void arm_tzc400_telemetry_setup(uintptr_t tzc_base);
 
 /* Console utility functions */
 void arm_console_boot_init(void);
@@ -296,6 +297,9 @@ void plat_arm_interconnect_exit_coherency(void);
 void plat_arm_program_trusted_mailbox(uintptr_t address);
 bool plat_arm_bl1_fwu_needed(void);
 __dead2 void plat_arm_error_handler(int err);
+#if TZC_TELEMETRY
+void plat_arm_tzc_telemetry_setup(void);
+#endif
 
 /*
  * Optional functions in ARM standard platforms
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -151,6 +151,9 @@ struct meminfo *bl1_plat_sec_mem_layout(void);
 void plat_sdei_setup(void);
 int plat_sdei_validate_entry_point(uintptr_t ep, unsigned int client_mode);
 void plat_sdei_handle_masked_trigger(uint64_t mpidr, unsigned int intr);
+#if SDEI_CONTEXT_BUFFER
+size_t plat_sdei_get_event_data(int ev_num, void *buf, size_t size);
+#endif
 #endif
 
 void plat_default_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
@@ -382,5 +385,7 @@ int plat_fwu_set_metadata_image_source(unsigned int image_id,
 				       uintptr_t *dev_handle,
 				       uintptr_t *image_spec);
 void plat_fwu_set_images_source(struct fwu_metadata *metadata);
+int plat_fwu_get_boot_attempts(uint32_t *metadata_crc, uint32_t *count);
+int plat_fwu_set_boot_attempts(uint32_t metadata_crc, uint32_t count);
 
 #endif /* PLATFORM_H */
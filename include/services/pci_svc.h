@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -23,6 +23,21 @@ uint64_t pci_smc_handler(uint32_t smc_fid, u_register_t x1, u_register_t x2,
 			 u_register_t x3,  u_register_t x4, void *cookie,
 			 void *handle, u_register_t flags);
 
+/*
+ * TF-A extension to DEN0115: performs a list of configuration space accesses
+ * described in Non-secure memory, see pci_batch_op_t. DEN0115 defines no such
+ * call, so it is allocated in the SiP range and dispatched by the SiP service
+ * of the platform.
+ */
+#define SMC_PCI_RW_BATCH		U(0x82000080)
+
+#define is_pci_batch_fid(_fid)		((_fid) == SMC_PCI_RW_BATCH)
+
+uintptr_t pci_batch_smc_handler(uint32_t smc_fid, u_register_t x1,
+				u_register_t x2, u_register_t x3,
+				u_register_t x4, void *cookie, void *handle,
+				u_register_t flags);
+
 #define PCI_ADDR_FUN(dev) ((dev) & U(0x7))
 #define PCI_ADDR_DEV(dev) (((dev) >> U(3))  & U(0x001F))
 #define PCI_ADDR_BUS(dev) (((dev) >> U(8))  & U(0x00FF))
@@ -56,4 +71,29 @@ uint32_t pci_get_bus_for_seg(uint32_t seg, uint32_t *bus_range, uint32_t *nseg);
 #define SMC_PCI_SZ_16BIT		U(2)
 #define SMC_PCI_SZ_32BIT		U(4)
 
+/*
+ * Entry of the list passed to SMC_PCI_RW_BATCH. 'addr', 'off', 'sz' and 'val'
+ * have the meaning of the SMC_PCI_READ and SMC_PCI_WRITE arguments. All the
+ * entries of a list must target the same segment. On return, 'status' holds
+ * the result of the access and 'val' the value read for read operations.
+ *
+ * The list must lie within the Non-secure window declared by the platform
+ * through PLAT_PCI_BATCH_NS_BUF_BASE and PLAT_PCI_BATCH_NS_BUF_SIZE, which
+ * BL31 maps as Non-secure memory.
+ */
+#define SMC_PCI_BATCH_OP_READ		U(0)
+#define SMC_PCI_BATCH_OP_WRITE		U(1)
+
+/* Maximum number of entries of a list, which must fit in a 4KB page */
+#define SMC_PCI_BATCH_MAX_OPS		U(256)
+
+typedef struct pci_batch_op {
+	uint32_t addr;
+	uint16_t off;
+	uint8_t sz;
+	uint8_t op;
+	uint32_t val;
+	int32_t status;
+} pci_batch_op_t;
+
 #endif /* PCI_SVC_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -34,6 +34,15 @@
 #define SDEI_PRIVATE_RESET			0xC4000031U
 #define SDEI_SHARED_RESET			0xC4000032U
 
+/*
+ * TF-A extension to register the buffer of the calling PE into which the
+ * context of the interrupted PE is copied on each event dispatch. The SDEI
+ * function ID range is reserved by the specification, so the call is allocated
+ * in the SiP range and dispatched by the SiP service of the platform.
+ */
+#define SDEI_EVENT_CONTEXT_BUFFER		0xC2000090U
+#define is_sdei_ctx_buf_fid(_fid)	((_fid) == SDEI_EVENT_CONTEXT_BUFFER)
+
 /* SDEI_EVENT_REGISTER flags */
 #define SDEI_REGF_RM_ANY	0ULL
 #define SDEI_REGF_RM_PE		1ULL
@@ -95,6 +104,25 @@
 		}, \
 	}
 
+/*
+ * The context buffer registered by SDEI_EVENT_CONTEXT_BUFFER is split in two
+ * halves, holding one record for the Normal and one for the Critical event
+ * being dispatched on the PE. The size of each record is half the size of the
+ * buffer, rounded down to a multiple of 8 bytes.
+ */
+#define SDEI_CTX_NUM_GPREGS	18U
+#define SDEI_CTX_REC_NORMAL	0U
+#define SDEI_CTX_REC_CRITICAL	1U
+
+typedef struct sdei_ctx_record {
+	int64_t ev_num;				/* Event being dispatched */
+	uint64_t x[SDEI_CTX_NUM_GPREGS];	/* Interrupted x0-x17 */
+	uint64_t elr;				/* Interrupted PC */
+	uint64_t spsr;				/* Interrupted PSTATE */
+	uint64_t data_size;			/* Size of event data */
+	uint8_t data[];				/* Event specific data */
+} sdei_ctx_record_t;
+
 typedef uint8_t sdei_state_t;
 
 /* Runtime data of SDEI event */
@@ -132,6 +160,18 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 		void *handle,
 		uint64_t flags);
 
+#if SDEI_CONTEXT_BUFFER
+/* Handler of SDEI_EVENT_CONTEXT_BUFFER, to be called by the SiP service */
+uint64_t sdei_ctx_buf_smc_handler(uint32_t smc_fid,
+		uint64_t x1,
+		uint64_t x2,
+		uint64_t x3,
+		uint64_t x4,
+		void *cookie,
+		void *handle,
+		uint64_t flags);
+#endif
+
 void sdei_init(void);
 
 /* Public API to dispatch an event to Normal world */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/boot_timeline/boot_timeline.h>
+#include <lib/cassert.h>
+#include <lib/pmf/pmf.h>
+
+/*
+ * The boot timeline buffer is reserved by the platform in memory that is
+ * preserved across the boot stages and mapped by each of them. It may be
+ * mapped as Device memory, so it is only accessed with naturally aligned
+ * loads and stores.
+ */
+#if !defined(PLAT_BOOT_TIMELINE_BASE) || !defined(PLAT_BOOT_TIMELINE_SIZE)
+#error "ENABLE_BOOT_TIMELINE requires PLAT_BOOT_TIMELINE_BASE/SIZE"
+#endif
+
+CASSERT((PLAT_BOOT_TIMELINE_BASE % sizeof(uint64_t)) == 0U,
+	assert_boot_timeline_base_unaligned);
+CASSERT(PLAT_BOOT_TIMELINE_SIZE >=
+	(sizeof(boot_timeline_t) + sizeof(boot_timeline_event_t)),
+	assert_boot_timeline_size_too_small);
+
+#define BOOT_TL_MAX_EVENTS						\
+	((PLAT_BOOT_TIMELINE_SIZE - sizeof(boot_timeline_t)) /		\
+	 sizeof(boot_timeline_event_t))
+
+/*
+ * The first stage to run after reset discards the timeline of any previous
+ * boot; the following stages append to it.
+ */
+#if defined(IMAGE_BL1)
+#define BOOT_TL_STAGE		BOOT_TL_STAGE_BL1
+#define BOOT_TL_FIRST_STAGE	1
+#elif defined(IMAGE_BL2)
+#define BOOT_TL_STAGE		BOOT_TL_STAGE_BL2
+#define BOOT_TL_FIRST_STAGE	BL2_AT_EL3
+#elif defined(IMAGE_BL31)
+#define BOOT_TL_STAGE		BOOT_TL_STAGE_BL31
+#define BOOT_TL_FIRST_STAGE	RESET_TO_BL31
+#endif
+
+/* Set once the current stage has attached to the timeline buffer */
+static boot_timeline_t *timeline;
+
+#ifdef BOOT_TL_STAGE
+void boot_timeline_init(void)
+{
+	boot_timeline_t *tl = (boot_timeline_t *)PLAT_BOOT_TIMELINE_BASE;
+
+	if ((BOOT_TL_FIRST_STAGE != 0) || (tl->magic != BOOT_TL_MAGIC) ||
+	    (tl->version != BOOT_TL_VERSION) ||
+	    (tl->max_events != BOOT_TL_MAX_EVENTS) ||
+	    (tl->num_events > tl->max_events)) {
+		tl->version = BOOT_TL_VERSION;
+		tl->max_events = BOOT_TL_MAX_EVENTS;
+		tl->num_events = 0U;
+		tl->dropped_events = 0U;
+		tl->reserved = 0U;
+		tl->cntfrq = 0U;
+		tl->magic = BOOT_TL_MAGIC;
+	}
+
+	/* The counter frequency may only be programmed by a later stage */
+	if (tl->cntfrq == 0U) {
+		tl->cntfrq = read_cntfrq_el0();
+	}
+
+	timeline = tl;
+}
+#else
+void boot_timeline_init(void)
+{
+}
+#endif /* BOOT_TL_STAGE */
+
+/*
+ * Record the start of a phase of the current stage. Returns the index of the
+ * event, to be passed to boot_timeline_end(), or BOOT_TL_INVALID_EVENT if the
+ * event could not be recorded.
+ */
+unsigned int boot_timeline_begin(unsigned int phase, unsigned int image_id)
+{
+#ifdef BOOT_TL_STAGE
+	boot_timeline_event_t *ev;
+	unsigned int idx;
+
+	if (timeline == NULL) {
+		return BOOT_TL_INVALID_EVENT;
+	}
+
+	idx = timeline->num_events;
+	if (idx >= timeline->max_events) {
+		timeline->dropped_events++;
+		return BOOT_TL_INVALID_EVENT;
+	}
+
+	ev = &timeline->events[idx];
+	ev->id = BOOT_TL_EVENT_ID(BOOT_TL_STAGE, phase, image_id);
+	ev->reserved = 0U;
+	ev->end = 0U;
+	ev->start = read_cntpct_el0();
+	timeline->num_events = idx + 1U;
+
+	return idx;
+#else
+	return BOOT_TL_INVALID_EVENT;
+#endif /* BOOT_TL_STAGE */
+}
+
+void boot_timeline_end(unsigned int event)
+{
+	if ((timeline == NULL) || (event >= timeline->num_events)) {
+		return;
+	}
+
+	timeline->events[event].end = read_cntpct_el0();
+}
+
+/*
+ * Write the timeline back to memory before handing over to the next stage,
+ * which may access it with the data cache disabled.
+ */
+void boot_timeline_flush(void)
+{
+	if (timeline == NULL) {
+		return;
+	}
+
+	flush_dcache_range((uintptr_t)timeline, PLAT_BOOT_TIMELINE_SIZE);
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+static unsigned long long ticks_to_us(unsigned long long ticks,
+				      unsigned long long freq)
+{
+	/* Split the conversion to avoid overflowing the multiplication */
+	return ((ticks / freq) * 1000000ULL) +
+	       (((ticks % freq) * 1000000ULL) / freq);
+}
+
+static const char *stage_name(unsigned int stage)
+{
+	static const char *const names[] = {
+		[BOOT_TL_STAGE_BL1] = "BL1",
+		[BOOT_TL_STAGE_BL2] = "BL2",
+		[BOOT_TL_STAGE_BL31] = "BL31",
+	};
+
+	if ((stage >= ARRAY_SIZE(names)) || (names[stage] == NULL)) {
+		return "?";
+	}
+
+	return names[stage];
+}
+
+static const char *phase_name(unsigned int phase)
+{
+	static const char *const names[] = {
+		[BOOT_TL_PHASE_STAGE] = "stage",
+		[BOOT_TL_PHASE_LOAD] = "load",
+		[BOOT_TL_PHASE_COPY] = "copy",
+		[BOOT_TL_PHASE_HASH] = "hash",
+		[BOOT_TL_PHASE_SIGNATURE] = "signature",
+	};
+
+	if (phase >= ARRAY_SIZE(names)) {
+		return "?";
+	}
+
+	return names[phase];
+}
+#endif /* LOG_LEVEL >= LOG_LEVEL_INFO */
+
+void boot_timeline_print(void)
+{
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+	unsigned long long freq;
+	unsigned int i;
+
+	if (timeline == NULL) {
+		return;
+	}
+
+	freq = timeline->cntfrq;
+	if (freq == 0ULL) {
+		WARN("Boot timeline: unknown counter frequency\n");
+		return;
+	}
+
+	INFO("Boot timeline (us): %u events, %u dropped\n",
+	     timeline->num_events, timeline->dropped_events);
+
+	for (i = 0U; i < timeline->num_events; i++) {
+		const boot_timeline_event_t *ev = &timeline->events[i];
+		unsigned int id = ev->id;
+		unsigned int image;
+		unsigned long long start, duration;
+
+		image = (id >> BOOT_TL_IMAGE_SHIFT) & BOOT_TL_IMAGE_MASK;
+		start = ticks_to_us(ev->start, freq);
+		duration = (ev->end >= ev->start) ?
+			   ticks_to_us(ev->end - ev->start, freq) : 0ULL;
+
+		if (image == BOOT_TL_NO_IMAGE) {
+			INFO("  %s %s: start %llu, duration %llu\n",
+			     stage_name((id >> BOOT_TL_STAGE_SHIFT) &
+					BOOT_TL_STAGE_MASK),
+			     phase_name((id >> BOOT_TL_PHASE_SHIFT) &
+					BOOT_TL_PHASE_MASK),
+			     start, duration);
+		} else {
+			INFO("  %s %s id=%u: start %llu, duration %llu\n",
+			     stage_name((id >> BOOT_TL_STAGE_SHIFT) &
+					BOOT_TL_STAGE_MASK),
+			     phase_name((id >> BOOT_TL_PHASE_SHIFT) &
+					BOOT_TL_PHASE_MASK),
+			     image, start, duration);
+		}
+	}
+#endif /* LOG_LEVEL >= LOG_LEVEL_INFO */
+}
+
+#if defined(IMAGE_BL31) && ENABLE_PMF
+/*
+ * Return the boot timeline through the PMF SMC interface. See the description
+ * of the BOOT_TL_PMF_* timestamp ids.
+ */
+static unsigned long long boot_timeline_get_ts(unsigned int tid,
+					       u_register_t mpidr,
+					       unsigned int flags)
+{
+	const boot_timeline_event_t *ev;
+	unsigned int idx = (tid & PMF_TID_MASK) >> PMF_TID_SHIFT;
+	unsigned int n;
+
+	if (timeline == NULL) {
+		return 0ULL;
+	}
+
+	if (idx == BOOT_TL_PMF_NUM_EVENTS) {
+		return timeline->num_events;
+	}
+
+	if (idx == BOOT_TL_PMF_CNTFRQ) {
+		return timeline->cntfrq;
+	}
+
+	n = (idx - BOOT_TL_PMF_EVENT_ID(0U)) / 3U;
+	if (n >= timeline->num_events) {
+		return 0ULL;
+	}
+
+	ev = &timeline->events[n];
+	switch (idx - BOOT_TL_PMF_EVENT_ID(n)) {
+	case 0U:
+		return ev->id;
+	case 1U:
+		return ev->start;
+	default:
+		return ev->end;
+	}
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(boot_timeline_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_BOOT_TIMELINE_SVC_ID, BOOT_TL_PMF_TOTAL_IDS, NULL,
+	boot_timeline_get_ts)
+#endif /* IMAGE_BL31 && ENABLE_PMF */
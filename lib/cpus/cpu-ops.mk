@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2014-2021, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
 # Copyright (c) 2020-2021, NVIDIA Corporation. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
@@ -29,6 +29,10 @@ DYNAMIC_WORKAROUND_CVE_2018_3639	?=0
 # By default internal
 NEOVERSE_Nx_EXTERNAL_LLC	?=0
 
+# Flag to reuse the cpu_ops pointer resolved on a previous boot in the BL31
+# warm boot reset handler. It is disabled by default.
+WARMBOOT_CACHED_CPU_OPS		?=0
+
 # Process A57_ENABLE_NONCACHEABLE_LOAD_FWD flag
 $(eval $(call assert_boolean,A57_ENABLE_NONCACHEABLE_LOAD_FWD))
 $(eval $(call add_define,A57_ENABLE_NONCACHEABLE_LOAD_FWD))
@@ -59,6 +63,9 @@ $(eval $(call add_define,DYNAMIC_WORKAROUND_CVE_2018_3639))
 $(eval $(call assert_boolean,NEOVERSE_Nx_EXTERNAL_LLC))
 $(eval $(call add_define,NEOVERSE_Nx_EXTERNAL_LLC))
 
+$(eval $(call assert_boolean,WARMBOOT_CACHED_CPU_OPS))
+$(eval $(call add_define,WARMBOOT_CACHED_CPU_OPS))
+
 ifneq (${DYNAMIC_WORKAROUND_CVE_2018_3639},0)
     ifeq (${WORKAROUND_CVE_2018_3639},0)
         $(error "Error: WORKAROUND_CVE_2018_3639 must be 1 if DYNAMIC_WORKAROUND_CVE_2018_3639 is 1")
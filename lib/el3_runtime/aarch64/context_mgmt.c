@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -438,6 +438,11 @@ static void manage_extensions_secure(cpu_context_t *ctx)
 	sve_disable(ctx);
   #endif /* ENABLE_SVE_FOR_SWD */
  #endif /* ENABLE_SVE_FOR_NS */
+
+#if MPAM_PARTITIONING
+	/* Assign the Secure world its platform defined PARTID and PMG */
+	mpam_init_secure_context(ctx);
+#endif /* MPAM_PARTITIONING */
 #endif /* IMAGE_BL31 */
 }
 
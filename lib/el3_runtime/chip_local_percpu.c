@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/el3_runtime/chip_local_percpu.h>
+#include <lib/utils.h>
+
+/*******************************************************************************
+ * Validate the chip-local regions described by the platform and zero them. This
+ * must be called by the primary CPU during cold boot, once the regions have
+ * been mapped and before any per-cpu data is populated.
+ ******************************************************************************/
+void chip_local_percpu_init(void)
+{
+	unsigned int chip;
+	const chip_local_region_t *region;
+
+	for (chip = 0U; chip < PLAT_CHIP_COUNT; chip++) {
+		region = &plat_chip_local_percpu_regions[chip];
+
+		if ((region->base == 0U) ||
+		    ((region->base & (CACHE_WRITEBACK_GRANULE - 1U)) != 0U) ||
+		    (region->size < CHIP_LOCAL_REGION_MIN_SIZE)) {
+			ERROR("Invalid chip-local per-cpu region for chip %u\n",
+			      chip);
+			panic();
+		}
+
+		zeromem((void *)region->base, CHIP_LOCAL_REGION_MIN_SIZE);
+
+		/*
+		 * Secondary CPUs may access their data with caches disabled on
+		 * the warm boot path, make sure the zeroed data has reached
+		 * memory.
+		 */
+		flush_dcache_range(region->base, CHIP_LOCAL_REGION_MIN_SIZE);
+
+		VERBOSE("Chip %u per-cpu data at 0x%lx\n", chip, region->base);
+	}
+}
+
+/*******************************************************************************
+ * Return the Non-secure cpu_context_t slot of the CPU with the given linear
+ * index, located in the memory region local to that CPU's chip.
+ ******************************************************************************/
+cpu_context_t *chip_local_ns_context_by_index(unsigned int cpu_idx)
+{
+	unsigned int chip = chip_local_chip_id(cpu_idx);
+	unsigned int local_idx = cpu_idx % PLAT_CHIP_CORE_COUNT;
+
+	assert(cpu_idx < PLATFORM_CORE_COUNT);
+
+	return (cpu_context_t *)(plat_chip_local_percpu_regions[chip].base +
+				 CHIP_LOCAL_CTX_OFFSET +
+				 (local_idx * CHIP_LOCAL_CTX_SLOT_SIZE));
+}
@@ -1,16 +1,91 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <assert.h>
 #include <stdbool.h>
 
 #include <arch.h>
 #include <arch_features.h>
 #include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/el3_runtime/context_mgmt.h>
 #include <lib/extensions/mpam.h>
 
+#if MPAM_PARTITIONING
+/*
+ * Return the value of an MPAMn_ELx register selecting the PARTID and PMG of
+ * 'cfg' for both instruction and data accesses. Panics if the PE does not
+ * implement them.
+ */
+static uint64_t mpam_partid_reg_val(const mpam_partid_cfg_t *cfg)
+{
+	uint64_t mpamidr = read_mpamidr_el1();
+
+	if ((cfg->partid > ((mpamidr >> MPAMIDR_PARTID_MAX_SHIFT) &
+			    MPAMIDR_PARTID_MAX_MASK)) ||
+	    (cfg->pmg > ((mpamidr >> MPAMIDR_PMG_MAX_SHIFT) &
+			 MPAMIDR_PMG_MAX_MASK))) {
+		ERROR("MPAM: PARTID %u/PMG %u not implemented\n",
+		      cfg->partid, cfg->pmg);
+		panic();
+	}
+
+	return ((uint64_t)cfg->partid << MPAMn_PARTID_I_SHIFT) |
+	       ((uint64_t)cfg->partid << MPAMn_PARTID_D_SHIFT) |
+	       ((uint64_t)cfg->pmg << MPAMn_PMG_I_SHIFT) |
+	       ((uint64_t)cfg->pmg << MPAMn_PMG_D_SHIFT);
+}
+#endif /* MPAM_PARTITIONING */
+
+/*
+ * Enable MPAM, and disable trapping to EL3 when lower ELs access their own MPAM
+ * registers. With MPAM_PARTITIONING, also tag the EL3 traffic with its
+ * platform defined PARTID and PMG.
+ */
+static void mpam_enable_el3(void)
+{
+	uint64_t mpam3_el3 = MPAM3_EL3_MPAMEN_BIT;
+
+#if MPAM_PARTITIONING
+	mpam3_el3 |= mpam_partid_reg_val(&plat_mpam_get_config()->el3);
+#endif
+
+	write_mpam3_el3(mpam3_el3);
+}
+
+#if MPAM_PARTITIONING
+/*
+ * Assign the platform defined Secure PARTID and PMG to the lower ELs of the
+ * Secure world, through the MPAMn_ELx values restored on entry to it. MPAM is
+ * enabled at this point, so that the Secure world is partitioned from its
+ * first entry, before the Non-secure world has been entered.
+ */
+void mpam_init_secure_context(cpu_context_t *ctx)
+{
+	const mpam_plat_config_t *cfg = plat_mpam_get_config();
+	uint64_t val;
+
+	assert(cfg != NULL);
+
+	if (get_mpam_version() == 0U) {
+		return;
+	}
+
+	mpam_enable_el3();
+
+	val = mpam_partid_reg_val(&cfg->secure);
+
+	write_ctx_reg(get_el1_sysregs_ctx(ctx), CTX_MPAM0_EL1, val);
+	write_ctx_reg(get_el1_sysregs_ctx(ctx), CTX_MPAM1_EL1, val);
+#if CTX_INCLUDE_EL2_REGS
+	write_ctx_reg(get_el2_sysregs_ctx(ctx), CTX_MPAM2_EL2, val);
+#endif
+}
+#endif /* MPAM_PARTITIONING */
+
 void mpam_enable(bool el2_unused)
 {
 	/* Check if MPAM is implemented */
@@ -18,11 +93,7 @@ void mpam_enable(bool el2_unused)
 		return;
 	}
 
-	/*
-	 * Enable MPAM, and disable trapping to EL3 when lower ELs access their
-	 * own MPAM registers.
-	 */
-	write_mpam3_el3(MPAM3_EL3_MPAMEN_BIT);
+	mpam_enable_el3();
 
 	/*
 	 * If EL2 is implemented but unused, disable trapping to EL2 when lower
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/extensions/mpam.h>
+#include <lib/mmio.h>
+#include <lib/utils_def.h>
+
+/* MSC MPAM feature page registers */
+#define MPAMF_IDR			U(0x0000)
+#define MPAMF_CPOR_IDR			U(0x0030)
+#define MPAMF_MBW_IDR			U(0x0040)
+#define MPAMCFG_PART_SEL		U(0x0100)
+#define MPAMCFG_MBW_MIN			U(0x0200)
+#define MPAMCFG_MBW_MAX			U(0x0208)
+#define MPAMCFG_CPBM(n)			(U(0x1000) + ((n) << 2))
+
+#define MPAMF_IDR_PARTID_MAX_MASK	U(0xffff)
+#define MPAMF_IDR_HAS_CPOR_PART		BIT_32(25)
+#define MPAMF_IDR_HAS_MBW_PART		BIT_32(26)
+
+#define MPAMF_CPOR_IDR_CPBM_WD_MASK	U(0xffff)
+
+#define MPAMF_MBW_IDR_HAS_MIN		BIT_32(10)
+#define MPAMF_MBW_IDR_HAS_MAX		BIT_32(11)
+
+#define MPAMCFG_PART_SEL_PARTID_MASK	U(0xffff)
+
+/* Number of bits held in a MPAMCFG_CPBM<n> register */
+#define MPAM_CPBM_REG_BITS		32U
+
+/*
+ * Program the cache portion bitmap of the currently selected partition. All
+ * the implemented portions are written, those beyond the 64 described by the
+ * platform are not allocated to the partition.
+ */
+static void mpam_msc_set_cpbm(uintptr_t base, uint64_t cpbm)
+{
+	unsigned int cpbm_wd = mmio_read_32(base + MPAMF_CPOR_IDR) &
+			       MPAMF_CPOR_IDR_CPBM_WD_MASK;
+	unsigned int n;
+	uint32_t val;
+
+	for (n = 0U; (n * MPAM_CPBM_REG_BITS) < cpbm_wd; n++) {
+		val = 0U;
+		if (n < 2U) {
+			val = (uint32_t)(cpbm >> (n * MPAM_CPBM_REG_BITS));
+		}
+
+		mmio_write_32(base + MPAMCFG_CPBM(n), val);
+	}
+}
+
+/* Check that the MSC implements the controls requested for a partition */
+static bool mpam_msc_part_supported(uintptr_t base,
+				    const mpam_msc_part_cfg_t *part)
+{
+	uint32_t idr = mmio_read_32(base + MPAMF_IDR);
+	uint32_t mbw_idr = 0U;
+
+	if ((idr & MPAMF_IDR_HAS_MBW_PART) != 0U) {
+		mbw_idr = mmio_read_32(base + MPAMF_MBW_IDR);
+	}
+
+	if (part->partid > (idr & MPAMF_IDR_PARTID_MAX_MASK)) {
+		return false;
+	}
+
+	if ((part->cpbm != 0U) && ((idr & MPAMF_IDR_HAS_CPOR_PART) == 0U)) {
+		return false;
+	}
+
+	if ((part->mbw_min != 0U) &&
+	    ((mbw_idr & MPAMF_MBW_IDR_HAS_MIN) == 0U)) {
+		return false;
+	}
+
+	return (part->mbw_max == 0U) ||
+	       ((mbw_idr & MPAMF_MBW_IDR_HAS_MAX) != 0U);
+}
+
+static void mpam_msc_set_part(const mpam_msc_desc_t *msc,
+			      const mpam_msc_part_cfg_t *part)
+{
+	uintptr_t base = part->ns ? msc->ns_base : msc->s_base;
+
+	assert(base != 0U);
+
+	if (!mpam_msc_part_supported(base, part)) {
+		ERROR("MPAM: MSC 0x%lx can't partition %s PARTID %u\n",
+		      base, part->ns ? "NS" : "S", part->partid);
+		panic();
+	}
+
+	mmio_write_32(base + MPAMCFG_PART_SEL,
+		      part->partid & MPAMCFG_PART_SEL_PARTID_MASK);
+
+	if (part->cpbm != 0U) {
+		mpam_msc_set_cpbm(base, part->cpbm);
+	}
+
+	if (part->mbw_min != 0U) {
+		mmio_write_32(base + MPAMCFG_MBW_MIN, part->mbw_min);
+	}
+
+	if (part->mbw_max != 0U) {
+		mmio_write_32(base + MPAMCFG_MBW_MAX, part->mbw_max);
+	}
+}
+
+/*******************************************************************************
+ * Program the cache portion and memory bandwidth partitions of the MSCs
+ * described by the platform. Must be called once by the primary CPU during
+ * cold boot, before the Secure and Non-secure worlds are entered.
+ ******************************************************************************/
+void mpam_msc_init(void)
+{
+	const mpam_plat_config_t *cfg = plat_mpam_get_config();
+	const mpam_msc_desc_t *msc;
+	unsigned int i, j;
+
+	assert(cfg != NULL);
+	assert((cfg->num_msc == 0U) || (cfg->msc != NULL));
+
+	for (i = 0U; i < cfg->num_msc; i++) {
+		msc = &cfg->msc[i];
+
+		for (j = 0U; j < msc->num_parts; j++) {
+			mpam_msc_set_part(msc, &msc->parts[j]);
+		}
+	}
+
+	/* Make sure the partitions are in place before any world runs */
+	dsbsy();
+
+	VERBOSE("MPAM: %u MSC(s) configured\n", cfg->num_msc);
+}
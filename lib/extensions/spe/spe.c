@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,6 +10,14 @@
 #include <arch_helpers.h>
 #include <lib/el3_runtime/pubsub.h>
 #include <lib/extensions/spe.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+#if NS_PROFILING_PAUSE
+/* Whether the profiling buffer of each CPU was stopped on Secure entry */
+static bool spe_paused[PLATFORM_CORE_COUNT];
+#endif
 
 static inline void psb_csync(void)
 {
@@ -73,13 +81,17 @@ void spe_disable(void)
 
 	/* Disable profiling buffer */
 	v = read_pmblimitr_el1();
-	v &= ~(1ULL << 0);
+	v &= ~PMBLIMITR_EL1_E_BIT;
 	write_pmblimitr_el1(v);
 	isb();
 }
 
 static void *spe_drain_buffers_hook(const void *arg)
 {
+#if NS_PROFILING_PAUSE
+	uint64_t v;
+#endif
+
 	if (!spe_supported())
 		return (void *)-1;
 
@@ -87,7 +99,40 @@ static void *spe_drain_buffers_hook(const void *arg)
 	psb_csync();
 	dsbnsh();
 
+#if NS_PROFILING_PAUSE
+	/*
+	 * Stop the Non-secure profiling buffer for the duration of the Secure
+	 * execution, so that no record is written while EL3 and the Secure
+	 * world run with a different view of memory.
+	 */
+	v = read_pmblimitr_el1();
+	if ((v & PMBLIMITR_EL1_E_BIT) != 0ULL) {
+		write_pmblimitr_el1(v & ~PMBLIMITR_EL1_E_BIT);
+		isb();
+		spe_paused[plat_my_core_pos()] = true;
+	}
+#endif
+
 	return (void *)0;
 }
 
 SUBSCRIBE_TO_EVENT(cm_entering_secure_world, spe_drain_buffers_hook);
+
+#if NS_PROFILING_PAUSE
+static void *spe_resume_buffer_hook(const void *arg)
+{
+	unsigned int core_pos = plat_my_core_pos();
+
+	if (!spe_paused[core_pos])
+		return (void *)0;
+
+	/* Restart the profiling buffer stopped on Secure entry */
+	write_pmblimitr_el1(read_pmblimitr_el1() | PMBLIMITR_EL1_E_BIT);
+	isb();
+	spe_paused[core_pos] = false;
+
+	return (void *)0;
+}
+
+SUBSCRIBE_TO_EVENT(cm_entering_normal_world, spe_resume_buffer_hook);
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +8,14 @@
 #include <arch_helpers.h>
 #include <lib/el3_runtime/pubsub.h>
 #include <lib/extensions/trbe.h>
+#include <plat/common/platform.h>
+
+#include <platform_def.h>
+
+#if NS_PROFILING_PAUSE
+/* Whether the trace buffer of each CPU was stopped on Secure entry */
+static bool trbe_paused[PLATFORM_CORE_COUNT];
+#endif
 
 static void tsb_csync(void)
 {
@@ -46,6 +54,10 @@ void trbe_enable(void)
 
 static void *trbe_drain_trace_buffers_hook(const void *arg __unused)
 {
+#if NS_PROFILING_PAUSE
+	uint64_t val;
+#endif
+
 	if (trbe_supported()) {
 		/*
 		 * Before switching from normal world to secure world
@@ -55,9 +67,40 @@ static void *trbe_drain_trace_buffers_hook(const void *arg __unused)
 		 */
 		tsb_csync();
 		dsbnsh();
+
+#if NS_PROFILING_PAUSE
+		/*
+		 * Stop the Non-secure trace buffer until the return to the
+		 * Normal world.
+		 */
+		val = read_trblimitr_el1();
+		if ((val & TRBLIMITR_EL1_E_BIT) != 0ULL) {
+			write_trblimitr_el1(val & ~TRBLIMITR_EL1_E_BIT);
+			isb();
+			trbe_paused[plat_my_core_pos()] = true;
+		}
+#endif
 	}
 
 	return (void *)0;
 }
 
 SUBSCRIBE_TO_EVENT(cm_entering_secure_world, trbe_drain_trace_buffers_hook);
+
+#if NS_PROFILING_PAUSE
+static void *trbe_resume_trace_buffer_hook(const void *arg __unused)
+{
+	unsigned int core_pos = plat_my_core_pos();
+
+	if (trbe_paused[core_pos]) {
+		/* Restart the trace buffer stopped on Secure entry */
+		write_trblimitr_el1(read_trblimitr_el1() | TRBLIMITR_EL1_E_BIT);
+		isb();
+		trbe_paused[core_pos] = false;
+	}
+
+	return (void *)0;
+}
+
+SUBSCRIBE_TO_EVENT(cm_entering_normal_world, trbe_resume_trace_buffer_hook);
+#endif
@@ -1,13 +1,18 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <lib/optee_utils.h>
+#if OPTEE_PAGEABLE_HASHES
+#include <drivers/auth/crypto_mod.h>
+#include <mbedtls/md.h>
+#endif
 
 /*
  * load_addr_hi and load_addr_lo: image load address.
@@ -124,9 +129,15 @@ static int parse_optee_image(image_info_t *image_info,
 	 */
 	image_info->h.attr &= ~IMAGE_ATTRIB_SKIP_LOADING;
 
-	/* Update image base and size of image_info */
+	/*
+	 * Update image base and size of image_info. The maximum size is
+	 * trimmed to what is left of the reserved area from the load address,
+	 * so that the image is loaded in place at the address requested by
+	 * the header without overrunning the reserved area.
+	 */
 	image_info->image_base = init_load_addr;
 	image_info->image_size = init_size;
+	image_info->image_max_size = (uint32_t)(free_end - init_load_addr + 1U);
 
 	return 0;
 }
@@ -232,3 +243,78 @@ int parse_optee_header(entry_point_info_t *header_ep,
 
 	return 0;
 }
+
+#if OPTEE_PAGEABLE_HASHES
+/*******************************************************************************
+ * Hash the pageable image page by page once it has been loaded, and place the
+ * resulting table right after the image, in the area reserved for it. The
+ * address of the table is handed to the BL32 SPD in arg4 so that OP-TEE can
+ * use the pageable image where it was loaded instead of relocating and hashing
+ * it again. Hashing is skipped (arg4 left as 0) if the image is not page
+ * aligned or if there is no room for the table.
+ * Return 0 on success or a negative error code otherwise.
+ ******************************************************************************/
+int optee_hash_pageable(entry_point_info_t *header_ep,
+			const image_info_t *paged_image_info)
+{
+	optee_pageable_hashes_t *table;
+	uintptr_t base, table_base, table_end, free_end;
+	size_t table_size;
+	uint32_t num_pages, page;
+	int rc;
+
+	assert(header_ep != NULL);
+	assert(paged_image_info != NULL);
+
+	header_ep->args.arg4 = 0U;
+
+	base = paged_image_info->image_base;
+	if ((paged_image_info->image_size == 0U) ||
+	    ((base & (OPTEE_PAGEABLE_PAGE_SIZE - 1U)) != 0U) ||
+	    ((paged_image_info->image_size &
+	      (OPTEE_PAGEABLE_PAGE_SIZE - 1U)) != 0U)) {
+		WARN("OPTEE pageable image not page aligned, not hashed\n");
+		return 0;
+	}
+
+	num_pages = paged_image_info->image_size / OPTEE_PAGEABLE_PAGE_SIZE;
+	table_size = sizeof(optee_pageable_hashes_t) +
+		     ((size_t)num_pages * OPTEE_PAGEABLE_HASH_SIZE);
+	table_base = base + paged_image_info->image_size;
+	table_end = table_base + table_size;
+	free_end = base + paged_image_info->image_max_size;
+	if ((table_end < table_base) || (table_end > free_end)) {
+		WARN("No room for the OPTEE pageable hashes\n");
+		return 0;
+	}
+
+	table = (optee_pageable_hashes_t *)table_base;
+	table->magic = OPTEE_PAGEABLE_HASHES_MAGIC;
+	table->version = OPTEE_PAGEABLE_HASHES_VERSION;
+	table->hash_len = OPTEE_PAGEABLE_HASH_SIZE;
+	table->page_size = OPTEE_PAGEABLE_PAGE_SIZE;
+	table->num_pages = num_pages;
+	table->base = base;
+	table->reserved = 0U;
+
+	for (page = 0U; page < num_pages; page++) {
+		rc = crypto_mod_calc_hash((unsigned int)MBEDTLS_MD_SHA256,
+				(void *)(base + (page * OPTEE_PAGEABLE_PAGE_SIZE)),
+				OPTEE_PAGEABLE_PAGE_SIZE,
+				&table->hashes[page * OPTEE_PAGEABLE_HASH_SIZE]);
+		if (rc != 0) {
+			ERROR("Failed to hash OPTEE pageable page %u\n", page);
+			return -1;
+		}
+	}
+
+	/* OP-TEE reads the table with the MMU and the caches disabled */
+	flush_dcache_range(table_base, table_size);
+
+	VERBOSE("OPTEE pageable hashes: %u pages at %p\n", num_pages,
+		(void *)table_base);
+	header_ep->args.arg4 = table_base;
+
+	return 0;
+}
+#endif /* OPTEE_PAGEABLE_HASHES */
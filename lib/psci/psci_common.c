@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -64,6 +64,14 @@ DEFINE_PSCI_LOCK(psci_locks[PSCI_NUM_NON_CPU_PWR_DOMAINS]);
 
 cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
 
+#if PSCI_FAST_RESUME
+/*
+ * Ancestor power domain nodes of each CPU, computed once during PSCI setup so
+ * that the warm boot path does not have to walk the power domain tree.
+ */
+unsigned int psci_cpu_parent_nodes[PLATFORM_CORE_COUNT][PLAT_MAX_PWR_LVL];
+#endif
+
 /*******************************************************************************
  * Pointer to functions exported by the platform to complete power mgmt. ops
  ******************************************************************************/
@@ -770,7 +778,11 @@ void psci_warmboot_entrypoint(void)
 {
 	unsigned int end_pwrlvl;
 	unsigned int cpu_idx = plat_my_core_pos();
+#if PSCI_FAST_RESUME
+	const unsigned int *parent_nodes = psci_cpu_parent_nodes[cpu_idx];
+#else
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+#endif
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
 
 	/*
@@ -788,8 +800,10 @@ void psci_warmboot_entrypoint(void)
 	 */
 	end_pwrlvl = get_power_on_target_pwrlvl();
 
+#if !PSCI_FAST_RESUME
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(cpu_idx, end_pwrlvl, parent_nodes);
+#endif
 
 	/*
 	 * This function acquires the lock corresponding to each power level so
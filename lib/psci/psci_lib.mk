@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -33,3 +33,7 @@ endif
 ifeq (${ENABLE_PSCI_STAT}, 1)
 PSCI_LIB_SOURCES		+=	lib/psci/psci_stat.c
 endif
+
+ifeq (${CHIP_LOCAL_PERCPU_DATA}, 1)
+PSCI_LIB_SOURCES		+=	lib/el3_runtime/chip_local_percpu.c
+endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -255,6 +255,9 @@ static inline void psci_lock_init(non_cpu_pd_node_t *non_cpu_pd_node,
 extern const plat_psci_ops_t *psci_plat_pm_ops;
 extern non_cpu_pd_node_t psci_non_cpu_pd_nodes[PSCI_NUM_NON_CPU_PWR_DOMAINS];
 extern cpu_pd_node_t psci_cpu_pd_nodes[PLATFORM_CORE_COUNT];
+#if PSCI_FAST_RESUME
+extern unsigned int psci_cpu_parent_nodes[PLATFORM_CORE_COUNT][PLAT_MAX_PWR_LVL];
+#endif
 extern unsigned int psci_caps;
 extern unsigned int psci_plat_core_count;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,9 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <context.h>
+#if CHIP_LOCAL_PERCPU_DATA
+#include <lib/el3_runtime/chip_local_percpu.h>
+#endif
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/cpus/errata_report.h>
 #include <plat/common/platform.h>
@@ -27,9 +30,12 @@ CASSERT(PLATFORM_CORE_COUNT <= (PSCI_MAX_CPUS_INDEX + 1U), assert_psci_cores_ove
  * Per cpu non-secure contexts used to program the architectural state prior
  * return to the normal world.
  * TODO: Use the memory allocator to set aside memory for the contexts instead
- * of relying on platform defined constants.
+ * of relying on platform defined constants. When CHIP_LOCAL_PERCPU_DATA is
+ * enabled, the contexts live in the chip-local per-cpu regions instead.
  ******************************************************************************/
+#if !CHIP_LOCAL_PERCPU_DATA
 static cpu_context_t psci_ns_context[PLATFORM_CORE_COUNT];
+#endif
 
 /******************************************************************************
  * Define the psci capability variable.
@@ -77,9 +83,15 @@ static void __init psci_init_pwr_domain_node(uint16_t node_idx,
 		psci_flush_dcache_range((uintptr_t)svc_cpu_data,
 						 sizeof(*svc_cpu_data));
 
+#if CHIP_LOCAL_PERCPU_DATA
+		cm_set_context_by_index(node_idx,
+					chip_local_ns_context_by_index(node_idx),
+					NON_SECURE);
+#else
 		cm_set_context_by_index(node_idx,
 					(void *) &psci_ns_context[node_idx],
 					NON_SECURE);
+#endif
 	}
 }
 
@@ -114,6 +126,27 @@ static void __init psci_update_pwrlvl_limits(void)
 	}
 }
 
+#if PSCI_FAST_RESUME
+/*******************************************************************************
+ * This function records the list of ancestor power domain nodes of each CPU
+ * in 'psci_cpu_parent_nodes'. The topology does not change after setup, so the
+ * warm boot path can use this list instead of walking the power domain tree.
+ ******************************************************************************/
+static void __init psci_init_cpu_parent_nodes(void)
+{
+	unsigned int cpu_idx;
+
+	for (cpu_idx = 0U; cpu_idx < psci_plat_core_count; cpu_idx++) {
+		psci_get_parent_pwr_domain_nodes(cpu_idx, PLAT_MAX_PWR_LVL,
+						 psci_cpu_parent_nodes[cpu_idx]);
+	}
+
+	/* Secondary CPUs may read the list with data caches disabled */
+	psci_flush_dcache_range((uintptr_t)psci_cpu_parent_nodes,
+				sizeof(psci_cpu_parent_nodes));
+}
+#endif /* PSCI_FAST_RESUME */
+
 /*******************************************************************************
  * Core routine to populate the power domain tree. The tree descriptor passed by
  * the platform is populated breadth-first and the first entry in the map
@@ -217,6 +250,11 @@ int __init psci_setup(const psci_lib_args_t *lib_args)
 	/* Update the CPU limits for each node in psci_non_cpu_pd_nodes */
 	psci_update_pwrlvl_limits();
 
+#if PSCI_FAST_RESUME
+	/* Snapshot the ancestors of each CPU for the warm boot path */
+	psci_init_cpu_parent_nodes();
+#endif
+
 	/* Populate the mpidr field of cpu node for this CPU */
 	psci_cpu_pd_nodes[plat_my_core_pos()].mpidr =
 		read_mpidr() & MPIDR_AFFINITY_MASK;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include <lib/semihosting.h>
+#include <lib/utils_def.h>
 
 #ifndef SEMIHOSTING_SUPPORTED
 #define SEMIHOSTING_SUPPORTED  1
@@ -16,6 +17,19 @@
 
 long semihosting_call(unsigned long operation, uintptr_t system_block_address);
 
+/* Number of traps to the host debugger, per operation */
+static unsigned int smh_trap_count[SEMIHOSTING_SYS_EXIT + 1];
+
+static long semihosting_trap(unsigned long operation,
+			     uintptr_t system_block_address)
+{
+	if (operation < ARRAY_SIZE(smh_trap_count)) {
+		smh_trap_count[operation]++;
+	}
+
+	return semihosting_call(operation, system_block_address);
+}
+
 typedef struct {
 	const char *file_name;
 	unsigned long mode;
@@ -51,7 +65,7 @@ long semihosting_file_open(const char *file_name, size_t mode)
 	open_block.mode = mode;
 	open_block.name_length = strlen(file_name);
 
-	return semihosting_call(SEMIHOSTING_SYS_OPEN, (uintptr_t)&open_block);
+	return semihosting_trap(SEMIHOSTING_SYS_OPEN, (uintptr_t)&open_block);
 }
 
 long semihosting_file_seek(long file_handle, ssize_t offset)
@@ -62,10 +76,10 @@ long semihosting_file_seek(long file_handle, ssize_t offset)
 	seek_block.handle = file_handle;
 	seek_block.location = offset;
 
-	result = semihosting_call(SEMIHOSTING_SYS_SEEK, (uintptr_t)&seek_block);
+	result = semihosting_trap(SEMIHOSTING_SYS_SEEK, (uintptr_t)&seek_block);
 
 	if (result != 0) {
-		result = semihosting_call(SEMIHOSTING_SYS_ERRNO, 0);
+		result = semihosting_trap(SEMIHOSTING_SYS_ERRNO, 0);
 	}
 
 	return result;
@@ -84,7 +98,7 @@ long semihosting_file_read(long file_handle, size_t *length, uintptr_t buffer)
 	read_block.buffer = buffer;
 	read_block.length = *length;
 
-	result = semihosting_call(SEMIHOSTING_SYS_READ, (uintptr_t)&read_block);
+	result = semihosting_trap(SEMIHOSTING_SYS_READ, (uintptr_t)&read_block);
 
 	if (result == *length) {
 		return -EINVAL;
@@ -110,7 +124,7 @@ long semihosting_file_write(long file_handle, size_t *length,
 	write_block.buffer = (uintptr_t)buffer; /* cast away const */
 	write_block.length = *length;
 
-	result = semihosting_call(SEMIHOSTING_SYS_WRITE,
+	result = semihosting_trap(SEMIHOSTING_SYS_WRITE,
 		(uintptr_t)&write_block);
 
 	*length = result;
@@ -120,27 +134,27 @@ long semihosting_file_write(long file_handle, size_t *length,
 
 long semihosting_file_close(long file_handle)
 {
-	return semihosting_call(SEMIHOSTING_SYS_CLOSE, (uintptr_t)&file_handle);
+	return semihosting_trap(SEMIHOSTING_SYS_CLOSE, (uintptr_t)&file_handle);
 }
 
 long semihosting_file_length(long file_handle)
 {
-	return semihosting_call(SEMIHOSTING_SYS_FLEN, (uintptr_t)&file_handle);
+	return semihosting_trap(SEMIHOSTING_SYS_FLEN, (uintptr_t)&file_handle);
 }
 
 char semihosting_read_char(void)
 {
-	return semihosting_call(SEMIHOSTING_SYS_READC, 0);
+	return semihosting_trap(SEMIHOSTING_SYS_READC, 0);
 }
 
 void semihosting_write_char(char character)
 {
-	semihosting_call(SEMIHOSTING_SYS_WRITEC, (uintptr_t)&character);
+	semihosting_trap(SEMIHOSTING_SYS_WRITEC, (uintptr_t)&character);
 }
 
 void semihosting_write_string(char *string)
 {
-	semihosting_call(SEMIHOSTING_SYS_WRITE0, (uintptr_t)string);
+	semihosting_trap(SEMIHOSTING_SYS_WRITE0, (uintptr_t)string);
 }
 
 long semihosting_system(char *command_line)
@@ -150,7 +164,7 @@ long semihosting_system(char *command_line)
 	system_block.command_line = command_line;
 	system_block.command_length = strlen(command_line);
 
-	return semihosting_call(SEMIHOSTING_SYS_SYSTEM,
+	return semihosting_trap(SEMIHOSTING_SYS_SYSTEM,
 		(uintptr_t)&system_block);
 }
 
@@ -220,14 +234,35 @@ semihosting_fail:
 	return ret;
 }
 
+/*
+ * Return the number of traps issued for a semihosting operation, or the total
+ * number of traps if 'operation' is SEMIHOSTING_SYS_ALL.
+ */
+unsigned int semihosting_get_trap_count(unsigned long operation)
+{
+	unsigned int count = 0U;
+	unsigned long i;
+
+	if (operation != SEMIHOSTING_SYS_ALL) {
+		return (operation < ARRAY_SIZE(smh_trap_count)) ?
+			smh_trap_count[operation] : 0U;
+	}
+
+	for (i = 0UL; i < ARRAY_SIZE(smh_trap_count); i++) {
+		count += smh_trap_count[i];
+	}
+
+	return count;
+}
+
 void semihosting_exit(uint32_t reason, uint32_t subcode)
 {
 #ifdef __aarch64__
 	uint64_t parameters[] = {reason, subcode};
 
-	(void)semihosting_call(SEMIHOSTING_SYS_EXIT, (uintptr_t)&parameters);
+	(void)semihosting_trap(SEMIHOSTING_SYS_EXIT, (uintptr_t)&parameters);
 #else
 	/* The subcode is not supported on AArch32. */
-	(void)semihosting_call(SEMIHOSTING_SYS_EXIT, reason);
+	(void)semihosting_trap(SEMIHOSTING_SYS_EXIT, reason);
 #endif
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -21,6 +21,79 @@
  */
 uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
+#if XLAT_TABLES_PREBUILT
+/*
+ * The default translation context and its tables have been generated at build
+ * time by xlat_gen, from the static memory map of the BL image. The regions
+ * added at run time must be part of that memory map.
+ */
+extern xlat_ctx_t tf_xlat_ctx;
+
+#if ENABLE_ASSERTIONS
+/* Number of regions of the prebuilt memory map added at run time */
+static unsigned int prebuilt_regions_added;
+
+static void check_prebuilt_region(const mmap_region_t *mm)
+{
+	const mmap_region_t *mm_cursor = tf_xlat_ctx.mmap;
+
+	/* Empty regions are ignored, as by mmap_add_region_ctx() */
+	if (mm->size == 0U) {
+		return;
+	}
+
+	while (mm_cursor->size != 0U) {
+		if ((mm_cursor->base_pa == mm->base_pa) &&
+		    (mm_cursor->base_va == mm->base_va) &&
+		    (mm_cursor->size == mm->size) &&
+		    (mm_cursor->attr == mm->attr) &&
+		    (mm_cursor->granularity == mm->granularity)) {
+			prebuilt_regions_added++;
+			return;
+		}
+		mm_cursor++;
+	}
+
+	ERROR("xlat: Region PA:0x%llx VA:0x%lx not in the prebuilt tables\n",
+	      mm->base_pa, mm->base_va);
+	panic();
+}
+#else
+static inline void check_prebuilt_region(const mmap_region_t *mm)
+{
+}
+#endif /* ENABLE_ASSERTIONS */
+
+void mmap_add_region(unsigned long long base_pa, uintptr_t base_va, size_t size,
+		     unsigned int attr)
+{
+	mmap_region_t mm = MAP_REGION(base_pa, base_va, size, attr);
+
+	check_prebuilt_region(&mm);
+}
+
+void mmap_add(const mmap_region_t *mm)
+{
+	while (mm->granularity != 0U) {
+		check_prebuilt_region(mm);
+		mm++;
+	}
+}
+
+void mmap_add_region_alloc_va(unsigned long long base_pa, uintptr_t *base_va,
+			      size_t size, unsigned int attr)
+{
+	ERROR("xlat: Can't allocate VAs with prebuilt tables\n");
+	panic();
+}
+
+void mmap_add_alloc_va(mmap_region_t *mm)
+{
+	ERROR("xlat: Can't allocate VAs with prebuilt tables\n");
+	panic();
+}
+
+#else /* !XLAT_TABLES_PREBUILT */
 /*
  * Allocate and initialise the default translation context for the BL image
  * currently executing.
@@ -59,6 +132,7 @@ void mmap_add_alloc_va(mmap_region_t *mm)
 		mm++;
 	}
 }
+#endif /* XLAT_TABLES_PREBUILT */
 
 #if PLAT_XLAT_TABLES_DYNAMIC
 
@@ -92,6 +166,36 @@ int mmap_remove_dynamic_region(uintptr_t base_va, size_t size)
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+#if XLAT_TABLES_PREBUILT
+void __init init_xlat_tables(void)
+{
+	unsigned int current_el __unused = xlat_arch_current_el();
+#if ENABLE_ASSERTIONS
+	unsigned int regions = 0U;
+
+	while (tf_xlat_ctx.mmap[regions].size != 0U) {
+		regions++;
+	}
+#endif
+
+	assert(!tf_xlat_ctx.initialized);
+
+	/* The tables must have been generated for the current regime */
+	assert(((current_el == 1U) &&
+		(tf_xlat_ctx.xlat_regime == EL1_EL0_REGIME)) ||
+	       ((current_el == 2U) && (tf_xlat_ctx.xlat_regime == EL2_REGIME)) ||
+	       ((current_el == 3U) && (tf_xlat_ctx.xlat_regime == EL3_REGIME)));
+
+	/* All the regions of the prebuilt tables must have been added */
+	assert(prebuilt_regions_added == regions);
+
+	assert(tf_xlat_ctx.max_pa <= xlat_arch_get_max_supported_pa());
+
+	tf_xlat_ctx.initialized = true;
+
+	xlat_tables_print(&tf_xlat_ctx);
+}
+#else /* !XLAT_TABLES_PREBUILT */
 void __init init_xlat_tables(void)
 {
 	assert(tf_xlat_ctx.xlat_regime == EL_REGIME_INVALID);
@@ -109,6 +213,7 @@ void __init init_xlat_tables(void)
 
 	init_xlat_tables_ctx(&tf_xlat_ctx);
 }
+#endif /* XLAT_TABLES_PREBUILT */
 
 int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr)
 {
@@ -117,7 +222,13 @@ int xlat_get_mem_attributes(uintptr_t base_va, uint32_t *attr)
 
 int xlat_change_mem_attributes(uintptr_t base_va, size_t size, uint32_t attr)
 {
+#if XLAT_TABLES_PREBUILT && !PLAT_XLAT_TABLES_DYNAMIC
+	/* The prebuilt tables are in read-only memory */
+	ERROR("xlat: Can't change the attributes of prebuilt tables\n");
+	return -1;
+#else
 	return xlat_change_mem_attributes_ctx(&tf_xlat_ctx, base_va, size, attr);
+#endif
 }
 
 #if PLAT_RO_XLAT_TABLES
@@ -443,6 +443,88 @@ ${LIB_DIR}/lib$(1).a: $(OBJS)
 	$$(Q)$$(AR) cr $$@ $$?
 endef
 
+# MAKE_BUILD_MESSAGE builds the object holding the build message and version
+# string of a BL image. Must be called from a recipe, without indentation.
+#   $(1) = output object
+define MAKE_BUILD_MESSAGE
+ifdef MAKE_BUILD_STRINGS
+	$(call MAKE_BUILD_STRINGS, $(1))
+else
+	@echo 'const char build_message[] = "Built : "$(BUILD_MESSAGE_TIMESTAMP); \
+	       const char version_string[] = "${VERSION_STRING}";' | \
+		$$(CC) $$(TF_CFLAGS) $$(CFLAGS) -xc -c - -o $(1)
+endif
+endef
+
+# LINK_BL links the objects of a BL image, as set up by MAKE_BL. Must be called
+# from a recipe, without indentation.
+#   $(1) = BL stage
+#   $(2) = output ELF
+#   $(3) = output map file
+#   $(4) = additional objects
+define LINK_BL
+ifneq ($(findstring armlink,$(notdir $(LD))),)
+	$$(Q)$$(LD) -o $(2) $$(TF_LDFLAGS) $$(LDFLAGS) $(BL_LDFLAGS) --entry=${1}_entrypoint \
+		--predefine="-D__LINKER__=$(__LINKER__)" \
+		--predefine="-DTF_CFLAGS=$(TF_CFLAGS)" \
+		--map --list="$(3)" --scatter=${PLAT_DIR}/scat/${1}.scat \
+		$(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS) \
+		$(BUILD_DIR)/build_message.o $(OBJS) $(4)
+else ifneq ($(findstring gcc,$(notdir $(LD))),)
+	$$(Q)$$(LD) -o $(2) $$(TF_LDFLAGS) $$(LDFLAGS) -Wl,-Map=$(3) \
+		-Wl,-T$(LINKERFILE) $(BUILD_DIR)/build_message.o \
+		$(OBJS) $(4) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
+else
+	$$(Q)$$(LD) -o $(2) $$(TF_LDFLAGS) $$(LDFLAGS) $(BL_LDFLAGS) -Map=$(3) \
+		--script $(LINKERFILE) $(BUILD_DIR)/build_message.o \
+		$(OBJS) $(4) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
+endif
+endef
+
+# MAKE_XLAT_PREBUILT generates the translation tables of a BL image from its
+# static memory map. The image is first linked with a stub of the tables, of
+# the same size as the generated ones, to get the addresses of the linker
+# symbols used by the memory map. The final image is checked to have the same
+# layout.
+#   $(1) = output directory
+#   $(2) = memory map (%.xlat)
+#   $(3) = BL stage
+define MAKE_XLAT_PREBUILT
+
+$(eval DEP := $(1)/xlat_prebuilt.i.d)
+$(eval BL_CPPFLAGS := $($(call uppercase,$(3))_CPPFLAGS) -DIMAGE_$(call uppercase,$(3)))
+$(eval BL_CFLAGS := $($(call uppercase,$(3))_CFLAGS))
+$(eval XLATGEN_FLAGS := $(if $(filter 1,$(ENABLE_BTI)),-b))
+
+$(1)/xlat_prebuilt_stub.c: | $(3)_dirs ${XLATGEN}
+	$$(ECHO) "  XLATGEN $$@"
+	$$(Q)$${XLATGEN} -o $$@
+
+$(1)/xlat_prebuilt_stub.o $(1)/xlat_prebuilt.o: %.o: %.c $(filter-out %.d,$(MAKEFILE_LIST))
+	$$(ECHO) "  CC      $$<"
+	$$(Q)$$(CC) $$(LTO_CFLAGS) $$(TF_CFLAGS) $$(CFLAGS) $(BL_CPPFLAGS) $(BL_CFLAGS) -c $$< -o $$@
+
+$(1)/xlat_prebuilt_stub.elf: $(OBJS) $(LINKERFILE) $(1)/xlat_prebuilt_stub.o | $(3)_dirs libraries $(BL_LIBS)
+	$$(ECHO) "  LD      $$@"
+$(call MAKE_BUILD_MESSAGE,$(1)/build_message.o)
+$(call LINK_BL,$(3),$$@,$(1)/xlat_prebuilt_stub.map,$(1)/xlat_prebuilt_stub.o)
+
+$(1)/xlat_prebuilt_stub.syms: $(1)/xlat_prebuilt_stub.elf
+	$$(ECHO) "  NM      $$@"
+	$$(Q)$$(NM) $$< > $$@
+
+$(1)/xlat_prebuilt.i: $(2) $(filter-out %.d,$(MAKEFILE_LIST)) | $(3)_dirs
+	$$(ECHO) "  PP      $$<"
+	$$(Q)$$(CPP) $$(CPPFLAGS) $(BL_CPPFLAGS) $(TF_CFLAGS_$(ARCH)) -P -x assembler-with-cpp -D__LINKER__ $(MAKE_DEP) -o $$@ $$<
+
+$(1)/xlat_prebuilt.c: $(1)/xlat_prebuilt.i $(1)/xlat_prebuilt_stub.syms | ${XLATGEN}
+	$$(ECHO) "  XLATGEN $$@"
+	$$(Q)$${XLATGEN} $(XLATGEN_FLAGS) -s $(1)/xlat_prebuilt_stub.syms -o $$@ $$<
+
+-include $(DEP)
+
+endef
+
 # MAKE_BL macro defines the targets and options to build each BL image.
 # Arguments:
 #   $(1) = BL stage
@@ -462,6 +544,10 @@ define MAKE_BL
         $(eval ENC_BIN    := $(call IMG_ENC_BIN,$(1)))
         $(eval BL_LINKERFILE := $($(call uppercase,$(1))_LINKERFILE))
         $(eval BL_LIBS    := $($(call uppercase,$(1))_LIBS))
+        $(eval XLAT_MAP   := $(if $(filter 1,$(XLAT_TABLES_PREBUILT)),$($(call uppercase,$(1))_XLAT_MAP)))
+        $(eval XLAT_OBJ   := $(if $(XLAT_MAP),$(BUILD_DIR)/xlat_prebuilt.o))
+        # Only the images linked with prebuilt tables expect them
+        $(if $(XLAT_MAP),$(eval $(call uppercase,$(1))_CPPFLAGS += -DXLAT_TABLES_PREBUILT=1))
         # We use sort only to get a list of unique object directory names.
         # ordering is not relevant but sort removes duplicates.
         $(eval TEMP_OBJ_DIRS := $(sort $(dir ${OBJS} ${LINKERFILE})))
@@ -484,35 +570,20 @@ ${1}_dirs: | ${OBJ_DIRS}
 $(eval $(call MAKE_OBJS,$(BUILD_DIR),$(SOURCES),$(1)))
 $(eval $(call MAKE_LD,$(LINKERFILE),$(BL_LINKERFILE),$(1)))
 $(eval BL_LDFLAGS := $($(call uppercase,$(1))_LDFLAGS))
+$(if $(XLAT_MAP),$(eval $(call MAKE_XLAT_PREBUILT,$(BUILD_DIR),$(XLAT_MAP),$(1))))
 
 ifeq ($(USE_ROMLIB),1)
 $(ELF): romlib.bin
 endif
 
-$(ELF): $(OBJS) $(LINKERFILE) | $(1)_dirs libraries $(BL_LIBS)
+$(ELF): $(OBJS) $(LINKERFILE) $(XLAT_OBJ) | $(1)_dirs libraries $(BL_LIBS)
 	$$(ECHO) "  LD      $$@"
-ifdef MAKE_BUILD_STRINGS
-	$(call MAKE_BUILD_STRINGS, $(BUILD_DIR)/build_message.o)
-else
-	@echo 'const char build_message[] = "Built : "$(BUILD_MESSAGE_TIMESTAMP); \
-	       const char version_string[] = "${VERSION_STRING}";' | \
-		$$(CC) $$(TF_CFLAGS) $$(CFLAGS) -xc -c - -o $(BUILD_DIR)/build_message.o
-endif
-ifneq ($(findstring armlink,$(notdir $(LD))),)
-	$$(Q)$$(LD) -o $$@ $$(TF_LDFLAGS) $$(LDFLAGS) $(BL_LDFLAGS) --entry=${1}_entrypoint \
-		--predefine="-D__LINKER__=$(__LINKER__)" \
-		--predefine="-DTF_CFLAGS=$(TF_CFLAGS)" \
-		--map --list="$(MAPFILE)" --scatter=${PLAT_DIR}/scat/${1}.scat \
-		$(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS) \
-		$(BUILD_DIR)/build_message.o $(OBJS)
-else ifneq ($(findstring gcc,$(notdir $(LD))),)
-	$$(Q)$$(LD) -o $$@ $$(TF_LDFLAGS) $$(LDFLAGS) -Wl,-Map=$(MAPFILE) \
-		-Wl,-T$(LINKERFILE) $(BUILD_DIR)/build_message.o \
-		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
-else
-	$$(Q)$$(LD) -o $$@ $$(TF_LDFLAGS) $$(LDFLAGS) $(BL_LDFLAGS) -Map=$(MAPFILE) \
-		--script $(LINKERFILE) $(BUILD_DIR)/build_message.o \
-		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
+$(call MAKE_BUILD_MESSAGE,$(BUILD_DIR)/build_message.o)
+$(call LINK_BL,$(1),$$@,$(MAPFILE),$(XLAT_OBJ))
+ifneq ($(XLAT_MAP),)
+	$$(Q)$$(NM) $$@ | cmp -s - $(BUILD_DIR)/xlat_prebuilt_stub.syms || \
+		(echo "Error: $$@ layout changed by the prebuilt xlat tables"; \
+		 exit 1)
 endif
 ifeq ($(DISABLE_BIN_GENERATION),1)
 	@${ECHO_BLANK_LINE}
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2016-2021, Arm Limited. All rights reserved.
+# Copyright (c) 2016-2022, Arm Limited. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -29,6 +29,9 @@ ARM_ARCH_MINOR			:= 0
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
+# Hash secure images while BL1 copies them during firmware update
+BL1_FWU_STREAM_HASH		:= 0
+
 # Execute BL2 at EL3
 BL2_AT_EL3			:= 0
 
@@ -45,6 +48,10 @@ BL2_INV_DCACHE			:= 1
 # Select the branch protection features to use.
 BRANCH_PROTECTION		:= 0
 
+# Place the per-cpu EL3 data of each chip's CPUs in a chip-local memory region
+# described by the platform. Only useful on multichip platforms.
+CHIP_LOCAL_PERCPU_DATA		:= 0
+
 # By default, consider that the platform may release several CPUs out of reset.
 # The platform Makefile is free to override this value.
 COLD_BOOT_SINGLE_CPU		:= 0
@@ -93,6 +100,10 @@ DISABLE_MTPMU			:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Record a timeline of the boot stages and image loads across BL1, BL2 and
+# BL31 in a platform-reserved buffer.
+ENABLE_BOOT_TIMELINE		:= 0
+
 # Build option to enable MPAM for lower ELs
 ENABLE_MPAM_FOR_LOWER_ELS	:= 0
 
@@ -123,6 +134,10 @@ ENABLE_STACK_PROTECTOR		:= 0
 # Flag to enable exception handling in EL3
 EL3_EXCEPTION_HANDLING		:= 0
 
+# Flag to enable interrupt latency instrumentation of the EL3 exception
+# handling framework
+EHF_INSTRUMENTATION		:= 0
+
 # Flag to enable Branch Target Identification.
 # Internal flag not meant for direct setting.
 # Use BRANCH_PROTECTION to enable BTI.
@@ -193,12 +208,33 @@ ifeq ($(KEY_ALG),rsa)
 KEY_SIZE			:= 2048
 endif
 
+# Avoid copying images whose memory-mapped source is their load address, and
+# authenticate certificates from their memory-mapped source
+LOAD_IMAGE_IN_PLACE		:= 0
+
 # Option to build TF with Measured Boot support
 MEASURED_BOOT			:= 0
 
+# Wait in WFE, woken up by the generic timer event stream, between the reads
+# of the mmio_poll_timeout() helpers
+MMIO_POLL_WFE			:= 0
+
+# Record per call site statistics of the mmio_poll_timeout() helpers
+MMIO_POLL_STATS			:= 0
+
+# Assign platform defined MPAM PARTIDs to EL3 and the Secure world, and
+# program the MSC partitions at boot
+MPAM_PARTITIONING		:= 0
+
+# Stop the NS SPE and TRBE buffers while the Secure world executes
+NS_PROFILING_PAUSE		:= 0
+
 # NS timer register save and restore
 NS_TIMER_SWITCH			:= 0
 
+# Hash the OP-TEE pageable image in BL2 and pass the hashes to OP-TEE
+OPTEE_PAGEABLE_HASHES		:= 0
+
 # Include lib/libc in the final image
 OVERRIDE_LIBC			:= 0
 
@@ -212,6 +248,9 @@ PROGRAMMABLE_RESET_ADDRESS	:= 0
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Precompute the per-cpu data needed on the PSCI warm boot path at cold boot
+PSCI_FAST_RESUME		:= 0
+
 # Enable RAS support
 RAS_EXTENSION			:= 0
 
@@ -224,12 +263,21 @@ SAVE_KEYS			:= 0
 # Software Delegated Exception support
 SDEI_SUPPORT			:= 0
 
+# Copy the interrupted context to a client registered buffer on SDEI dispatch
+SDEI_CONTEXT_BUFFER		:= 0
+
 # True Random Number firmware Interface
 TRNG_SUPPORT			:= 0
 
 # SMCCC PCI support
 SMC_PCI_SUPPORT			:= 0
 
+# Vectored configuration space accesses through the SMCCC PCI service
+SMC_PCI_BATCH			:= 0
+
+# Flag to enable accounting of the time spent in the Secure world
+SECURE_TIME_INSTRUMENTATION	:= 0
+
 # Whether code and read-only data should be put on separate memory pages. The
 # platform Makefile is free to override this value.
 SEPARATE_CODE_AND_RODATA	:= 0
@@ -258,6 +306,9 @@ SPIN_ON_BL1_EXIT		:= 0
 # Flags to build TF with Trusted Boot support
 TRUSTED_BOARD_BOOT		:= 0
 
+# Record failed accesses reported by the TZC-400 and DMC-500 controllers
+TZC_TELEMETRY			:= 0
+
 # Build option to choose whether Trusted Firmware uses Coherent memory or not.
 USE_COHERENT_MEM		:= 1
 
@@ -298,6 +349,10 @@ V				:= 0
 # platforms).
 WARMBOOT_ENABLE_DCACHE_EARLY	:= 0
 
+# Build the translation tables of the BL images from their static memory map,
+# given by <BL>_XLAT_MAP, instead of building them at boot.
+XLAT_TABLES_PREBUILT		:= 0
+
 # Build option to enable/disable the Statistical Profiling Extensions
 ENABLE_SPE_FOR_LOWER_ELS	:= 1
 
@@ -376,6 +431,10 @@ NR_OF_IMAGES_IN_FW_BANK		:= 1
 # Disable Firmware update support by default
 PSA_FWU_SUPPORT			:= 0
 
+# Number of boot attempts allowed for a firmware bank in trial state before
+# rolling back to the previous active bank, 0 disables the boot attempt counter
+PSA_FWU_TRIAL_BOOT_MAX		:= 0
+
 # By default, disable access of trace buffer control registers from NS
 # lower ELs  i.e. NS-EL2, or NS-EL1 if NS-EL2 implemented but unused
 # if FEAT_TRBE is implemented.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <common/debug.h>
 #include <common/desc_image_load.h>
 #include <drivers/arm/sp804_delay_timer.h>
+#include <drivers/io/io_semihosting.h>
 #include <lib/fconf/fconf.h>
 #include <lib/fconf/fconf_dyn_cfg_getter.h>
 
@@ -41,6 +42,9 @@ struct bl_params *plat_get_next_bl_params(void)
 {
 	struct bl_params *arm_bl_params;
 
+	/* All the images have been loaded at this point */
+	io_sh_print_stats();
+
 	arm_bl_params = arm_get_next_bl_params();
 
 #if __aarch64__ && !BL2_AT_EL3
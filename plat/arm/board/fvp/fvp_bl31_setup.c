@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -103,3 +103,13 @@ unsigned int plat_get_syscnt_freq2(void)
 
 	return counter_base_frequency;
 }
+
+#if TZC_TELEMETRY
+void plat_arm_tzc_telemetry_setup(void)
+{
+	/* The Foundation FVP does not have a TrustZone controller */
+	if ((get_arm_config()->flags & ARM_CONFIG_HAS_TZC) != 0U) {
+		arm_tzc400_telemetry_setup(PLAT_ARM_TZC_BASE);
+	}
+}
+#endif /* TZC_TELEMETRY */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -315,7 +315,17 @@
 	INTR_PROP_DESC(FVP_IRQ_SEC_SYS_TIMER, GIC_HIGHEST_SEC_PRIORITY, (grp), \
 			GIC_INTR_CFG_LEVEL)
 
+#if TZC_TELEMETRY
+#define PLAT_ARM_G0_IRQ_PROPS(grp) \
+	ARM_G0_IRQ_PROPS(grp), \
+	INTR_PROP_DESC(FVP_IRQ_TZC400, PLAT_TZC_TELEMETRY_PRI, (grp), \
+			GIC_INTR_CFG_LEVEL)
+
+/* Priority of the TZC failed access interrupt, handled through the EHF */
+#define PLAT_EHF_DESC	EHF_PRI_DESC(PLAT_PRI_BITS, PLAT_TZC_TELEMETRY_PRI)
+#else
 #define PLAT_ARM_G0_IRQ_PROPS(grp)	ARM_G0_IRQ_PROPS(grp)
+#endif
 
 #if SDEI_IN_FCONF
 #define PLAT_SDEI_DP_EVENT_MAX_CNT	ARM_SDEI_DP_EVENT_MAX_CNT
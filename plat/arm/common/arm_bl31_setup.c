@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -292,6 +292,10 @@ void arm_bl31_platform_setup(void)
 	ras_init();
 #endif
 
+#if TZC_TELEMETRY
+	plat_arm_tzc_telemetry_setup();
+#endif
+
 #if USE_DEBUGFS
 	debugfs_init();
 #endif /* USE_DEBUGFS */
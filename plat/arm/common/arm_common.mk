@@ -301,7 +301,8 @@ BL31_SOURCES		+=	plat/arm/common/arm_bl31_setup.c		\
 				plat/arm/common/arm_topology.c			\
 				plat/common/plat_psci_common.c
 
-ifneq ($(filter 1,${ENABLE_PMF} ${ARM_ETHOSN_NPU_DRIVER}),)
+ifneq ($(filter 1,${ENABLE_PMF} ${ARM_ETHOSN_NPU_DRIVER} ${TZC_TELEMETRY} \
+			  ${SMC_PCI_BATCH} ${SDEI_CONTEXT_BUFFER}),)
 ARM_SVC_HANDLER_SRCS :=
 
 ifeq (${ENABLE_PMF},1)
@@ -314,6 +315,10 @@ ARM_SVC_HANDLER_SRCS	+=	plat/arm/common/fconf/fconf_ethosn_getter.c	\
 				drivers/arm/ethosn/ethosn_smc.c
 endif
 
+ifeq (${TZC_TELEMETRY},1)
+ARM_SVC_HANDLER_SRCS	+=	drivers/arm/tzc/tzc_telemetry_smc.c
+endif
+
 ifeq (${ARCH}, aarch64)
 BL31_SOURCES		+=	plat/arm/common/aarch64/execution_state_switch.c\
 				plat/arm/common/arm_sip_svc.c			\
@@ -335,6 +340,13 @@ BL31_SOURCES		+=	plat/arm/common/fconf/fconf_sdei_getter.c
 endif
 endif
 
+ifeq (${TZC_TELEMETRY},1)
+ifeq (${EL3_EXCEPTION_HANDLING},0)
+  $(error EL3_EXCEPTION_HANDLING must be 1 for TZC_TELEMETRY support)
+endif
+BL31_SOURCES		+=	plat/arm/common/arm_tzc_telemetry.c
+endif
+
 # RAS sources
 ifeq (${RAS_EXTENSION},1)
 BL31_SOURCES		+=	lib/extensions/ras/std_err_record.c		\
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2019,2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2019,2021-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,10 +9,13 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/arm/ethosn.h>
+#include <drivers/arm/tzc_telemetry.h>
 #include <lib/debugfs.h>
 #include <lib/pmf/pmf.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
+#include <services/pci_svc.h>
+#include <services/sdei.h>
 #include <tools_share/uuid.h>
 
 /* ARM SiP Service UUID */
@@ -82,6 +85,33 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 
 #endif /* ARM_ETHOSN_NPU_DRIVER */
 
+#if TZC_TELEMETRY
+
+	if (is_tzc_telemetry_fid(smc_fid)) {
+		return tzc_telemetry_smc_handler(smc_fid, x1, x2, x3, x4,
+						 cookie, handle, flags);
+	}
+
+#endif /* TZC_TELEMETRY */
+
+#if SMC_PCI_BATCH
+
+	if (is_pci_batch_fid(smc_fid)) {
+		return pci_batch_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					     handle, flags);
+	}
+
+#endif /* SMC_PCI_BATCH */
+
+#if SDEI_CONTEXT_BUFFER
+
+	if (is_sdei_ctx_buf_fid(smc_fid)) {
+		return sdei_ctx_buf_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+						handle, flags);
+	}
+
+#endif /* SDEI_CONTEXT_BUFFER */
+
 	switch (smc_fid) {
 	case ARM_SIP_SVC_EXE_STATE_SWITCH: {
 		/* Execution state can be switched only if EL3 is AArch64 */
@@ -111,6 +141,21 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		call_count += ETHOSN_NUM_SMC_CALLS;
 #endif /* ARM_ETHOSN_NPU_DRIVER */
 
+#if TZC_TELEMETRY
+		/* TZC telemetry calls */
+		call_count += TZC_TELEMETRY_NUM_SMC_CALLS;
+#endif /* TZC_TELEMETRY */
+
+#if SMC_PCI_BATCH
+		/* PCI batch call */
+		call_count += 1;
+#endif /* SMC_PCI_BATCH */
+
+#if SDEI_CONTEXT_BUFFER
+		/* SDEI context buffer call */
+		call_count += 1;
+#endif /* SDEI_CONTEXT_BUFFER */
+
 		/* State switch call */
 		call_count += 1;
 
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <bl31/ehf.h>
+#include <drivers/arm/tzc400.h>
+#include <plat/arm/common/plat_arm.h>
+#include <plat/common/platform.h>
+#include <platform_def.h>
+
+/*
+ * Handler of the TZC-400 failed access interrupt. The interrupt has already
+ * been acknowledged by the EHF; the driver records the fault into the
+ * telemetry and clears it on the controller.
+ */
+static int arm_tzc400_telemetry_handler(uint32_t intr_raw, uint32_t flags,
+					void *handle, void *cookie)
+{
+	(void)tzc400_it_handler();
+
+	plat_ic_end_of_interrupt(intr_raw);
+
+	return 0;
+}
+
+/*
+ * Route the failed accesses of the TZC-400 at 'tzc_base' to BL31. The
+ * controller is kept raising a bus error on the faulting access, in addition
+ * to the interrupt handled by the EHF at PLAT_TZC_TELEMETRY_PRI.
+ */
+void arm_tzc400_telemetry_setup(uintptr_t tzc_base)
+{
+	tzc400_init(tzc_base);
+	tzc400_set_action(TZC_ACTION_ERR_INT);
+
+	ehf_register_priority_handler(PLAT_TZC_TELEMETRY_PRI,
+				      arm_tzc400_telemetry_handler);
+}
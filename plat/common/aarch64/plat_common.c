@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -28,6 +28,9 @@
 #if SDEI_SUPPORT
 #pragma weak plat_sdei_handle_masked_trigger
 #pragma weak plat_sdei_validate_entry_point
+#if SDEI_CONTEXT_BUFFER
+#pragma weak plat_sdei_get_event_data
+#endif
 #endif
 
 #pragma weak plat_ea_handler = plat_default_ea_handler
@@ -66,6 +69,17 @@ int plat_sdei_validate_entry_point(uintptr_t ep, unsigned int client_mode)
 {
 	return 0;
 }
+
+#if SDEI_CONTEXT_BUFFER
+/*
+ * Default function to provide event specific data, such as an error syndrome,
+ * to be copied along with the interrupted context. No data is provided.
+ */
+size_t plat_sdei_get_event_data(int ev_num, void *buf, size_t size)
+{
+	return 0U;
+}
+#endif
 #endif
 
 #if !ENABLE_BACKTRACE
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -184,6 +184,17 @@ static int qemu_bl2_handle_post_image_load(unsigned int image_id)
 		bl_mem_params->ep_info.spsr = qemu_get_spsr_for_bl32_entry();
 		break;
 
+#if defined(SPD_opteed) && OPTEE_PAGEABLE_HASHES
+	case BL32_EXTRA2_IMAGE_ID:
+		/* The header image has been parsed before the pageable image */
+		pager_mem_params = get_bl_mem_params_node(BL32_IMAGE_ID);
+		assert(pager_mem_params);
+
+		err = optee_hash_pageable(&pager_mem_params->ep_info,
+					  &bl_mem_params->image_info);
+		break;
+#endif
+
 	case BL33_IMAGE_ID:
 #ifdef AARCH32_SP_OPTEE
 		/* AArch32 only core: OP-TEE expects NSec EP in register LR */
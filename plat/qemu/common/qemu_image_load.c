@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <common/desc_image_load.h>
+#include <drivers/io/io_semihosting.h>
 
 /*******************************************************************************
  * This function is a wrapper of a common function which flushes the data
@@ -30,5 +31,8 @@ bl_load_info_t *plat_get_bl_image_load_info(void)
  ******************************************************************************/
 bl_params_t *plat_get_next_bl_params(void)
 {
+	/* All the images have been loaded at this point */
+	io_sh_print_stats();
+
 	return get_next_bl_params_from_mem_params_desc();
 }
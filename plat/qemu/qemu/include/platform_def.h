@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -115,6 +115,11 @@
 #define PLAT_QEMU_HOLD_STATE_WAIT	0
 #define PLAT_QEMU_HOLD_STATE_GO		1
 
+/* Boot timeline, in the upper half of the shared RAM */
+#define PLAT_BOOT_TIMELINE_SIZE		0x800
+#define PLAT_BOOT_TIMELINE_BASE		(SHARED_RAM_BASE + SHARED_RAM_SIZE - \
+					 PLAT_BOOT_TIMELINE_SIZE)
+
 #define BL_RAM_BASE			(SHARED_RAM_BASE + SHARED_RAM_SIZE)
 #define BL_RAM_SIZE			(SEC_SRAM_SIZE - SHARED_RAM_SIZE)
 
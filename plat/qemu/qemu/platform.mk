@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -51,6 +51,9 @@ PLAT_BL_COMMON_SOURCES	:=	${PLAT_QEMU_COMMON_PATH}/qemu_common.c			\
 include lib/xlat_tables_v2/xlat_tables.mk
 PLAT_BL_COMMON_SOURCES	+=	${XLAT_TABLES_LIB_SRCS}
 
+# Static memory map of BL31, used when XLAT_TABLES_PREBUILT=1
+BL31_XLAT_MAP		:=	${PLAT_QEMU_COMMON_PATH}/qemu_bl31.xlat
+
 ifneq (${TRUSTED_BOARD_BOOT},0)
 
     include drivers/auth/mbedtls/mbedtls_crypto.mk
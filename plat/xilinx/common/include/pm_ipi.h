@@ -9,6 +9,7 @@
 #define PM_IPI_H
 
 #include <plat_ipi.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include "pm_common.h"
 
@@ -16,6 +17,7 @@
 #define IPI_NON_BLOCKING	0
 
 int pm_ipi_init(const struct pm_proc *proc);
+enum pm_ret_status pm_ipi_wait_idle(const struct pm_proc *proc);
 
 enum pm_ret_status pm_ipi_send(const struct pm_proc *proc,
 			       uint32_t payload[PAYLOAD_ARG_CNT]);
@@ -24,6 +26,13 @@ enum pm_ret_status pm_ipi_send_non_blocking(const struct pm_proc *proc,
 enum pm_ret_status pm_ipi_send_sync(const struct pm_proc *proc,
 				    uint32_t payload[PAYLOAD_ARG_CNT],
 				    unsigned int *value, size_t count);
+enum pm_ret_status pm_ipi_send_yield(const struct pm_proc *proc,
+				     uint32_t payload[PAYLOAD_ARG_CNT],
+				     uint32_t sec_state, uint32_t *token);
+bool pm_ipi_yield_poll(uint32_t token, uint32_t sec_state, uint32_t *api_id,
+		       enum pm_ret_status *status, unsigned int *value,
+		       size_t count);
+enum pm_ret_status pm_ipi_yield_abort(uint32_t token, uint32_t sec_state);
 void pm_ipi_buff_read_callb(unsigned int *value, size_t count);
 void pm_ipi_irq_enable(const struct pm_proc *proc);
 void pm_ipi_irq_clear(const struct pm_proc *proc);
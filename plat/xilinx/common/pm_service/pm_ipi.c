@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 
 #include <arch_helpers.h>
+#include <drivers/delay_timer.h>
 #include <lib/bakery_lock.h>
 #include <lib/mmio.h>
 #include <ipi.h>
@@ -18,8 +19,66 @@
 
 #define ERROR_CODE_MASK		0xFFFFU
 
+#define PM_IPI_YIELD_IDLE	0U
+#define PM_IPI_YIELD_PENDING	1U
+#define PM_IPI_YIELD_DONE	2U
+#define PM_IPI_YIELD_ABORTED	3U
+
+/*
+ * Time after which a yielding request that its owner has stopped polling can
+ * be reclaimed by another caller.
+ */
+#ifndef PM_IPI_YIELD_TIMEOUT_US
+#define PM_IPI_YIELD_TIMEOUT_US	1000000U
+#endif
+
+/*
+ * Time after which a request waiting for the yielding request in flight to
+ * be handled by the remote processor fails with PM_RET_ERROR_TIMEOUT.
+ */
+#ifndef PM_IPI_YIELD_WAIT_TIMEOUT_US
+#define PM_IPI_YIELD_WAIT_TIMEOUT_US	PM_IPI_YIELD_TIMEOUT_US
+#endif
+
+/*
+ * Time after which a request posted without waiting for its response, e.g.
+ * PM_SELF_SUSPEND, is considered lost by the remote processor.
+ */
+#ifndef PM_IPI_IDLE_TIMEOUT_US
+#define PM_IPI_IDLE_TIMEOUT_US	100000U
+#endif
+
 DEFINE_BAKERY_LOCK(pm_secure_lock);
 
+/**
+ * pm_ipi_yield - Request sent without waiting for the remote processor
+ * @proc	Processor which sent the request
+ * @state	PM_IPI_YIELD_IDLE, PM_IPI_YIELD_PENDING, PM_IPI_YIELD_DONE or
+ *		PM_IPI_YIELD_ABORTED (still processed by the remote processor,
+ *		but its response is discarded)
+ * @token	Token identifying the request, returned to its caller
+ * @sec_state	Security state of the caller which sent the request
+ * @last_token	Last token handed out, see pm_ipi_send_yield()
+ * @api_id	API id of the request
+ * @expire	Counter value after which the request can be reclaimed
+ * @response	Response of the request once handled
+ *
+ * Protected by 'pm_secure_lock'.
+ */
+static struct {
+	const struct pm_proc *proc;
+	uint32_t state;
+	uint32_t token;
+	uint32_t sec_state;
+	uint32_t last_token;
+	uint32_t api_id;
+	uint64_t expire;
+	uint32_t response[PAYLOAD_ARG_CNT];
+} pm_ipi_yield;
+
+static enum pm_ret_status pm_ipi_buff_read(const struct pm_proc *proc,
+					   unsigned int *value, size_t count);
+
 /**
  * pm_ipi_init() - Initialize IPI peripheral for communication with
  *		   remote processor
@@ -39,6 +98,42 @@ int pm_ipi_init(const struct pm_proc *proc)
 	return 0;
 }
 
+/**
+ * pm_ipi_yield_collect() - Collects the response of the yielding request
+ *			    once the remote processor has handled it
+ *
+ * Caller needs to hold the 'pm_secure_lock' lock.
+ *
+ * @return	Returns true if the request is still processed by the remote
+ *		processor, false otherwise
+ */
+static bool pm_ipi_yield_collect(void)
+{
+	const struct pm_proc *proc = pm_ipi_yield.proc;
+
+	if ((pm_ipi_yield.state != PM_IPI_YIELD_PENDING) &&
+	    (pm_ipi_yield.state != PM_IPI_YIELD_ABORTED)) {
+		return false;
+	}
+
+	if ((ipi_mb_enquire_status(proc->ipi->local_ipi_id,
+				   proc->ipi->remote_ipi_id) &
+	     IPI_MB_STATUS_SEND_PENDING) != 0) {
+		return true;
+	}
+
+	if (pm_ipi_yield.state == PM_IPI_YIELD_PENDING) {
+		pm_ipi_yield.response[0] = pm_ipi_buff_read(proc,
+						&pm_ipi_yield.response[1],
+						PAYLOAD_ARG_CNT - 1U);
+		pm_ipi_yield.state = PM_IPI_YIELD_DONE;
+	} else {
+		pm_ipi_yield.state = PM_IPI_YIELD_IDLE;
+	}
+
+	return false;
+}
+
 /**
  * pm_ipi_send_common() - Sends IPI request to the remote processor
  * @proc	Pointer to the processor who is initiating request
@@ -47,7 +142,10 @@ int pm_ipi_init(const struct pm_proc *proc)
  * Send an IPI request to the power controller. Caller needs to hold
  * the 'pm_secure_lock' lock.
  *
- * @return	Returns status, either success or error+reason
+ * @return	Returns status, either success or error+reason. Fails with
+ *		PM_RET_ERROR_TIMEOUT if a yielding request is still handled by
+ *		the remote processor after PM_IPI_YIELD_WAIT_TIMEOUT_US, or
+ *		a posted request after PM_IPI_IDLE_TIMEOUT_US.
  */
 static enum pm_ret_status pm_ipi_send_common(const struct pm_proc *proc,
 					     uint32_t payload[PAYLOAD_ARG_CNT],
@@ -57,6 +155,31 @@ static enum pm_ret_status pm_ipi_send_common(const struct pm_proc *proc,
 	uintptr_t buffer_base = proc->ipi->buffer_base +
 					IPI_BUFFER_TARGET_REMOTE_OFFSET +
 					IPI_BUFFER_REQ_OFFSET;
+	uint64_t timeout = timeout_init_us(PM_IPI_YIELD_WAIT_TIMEOUT_US);
+
+	/*
+	 * Wait for a yielding request still processed by the remote processor
+	 * before the IPI buffer is overwritten. The lock is dropped between
+	 * polls so that the other cores are not stalled for the whole duration
+	 * of the request, e.g. a bitstream load.
+	 */
+	while (pm_ipi_yield_collect()) {
+		if (timeout_elapsed(timeout)) {
+			return PM_RET_ERROR_TIMEOUT;
+		}
+
+		bakery_lock_release(&pm_secure_lock);
+		bakery_lock_get(&pm_secure_lock);
+	}
+
+	/*
+	 * A request posted with pm_ipi_send_non_blocking() may still be
+	 * pending, do not overwrite it.
+	 */
+	if (pm_ipi_wait_idle(proc) != PM_RET_SUCCESS) {
+		return PM_RET_ERROR_TIMEOUT;
+	}
+
 #if IPI_CRC_CHECK
 	payload[PAYLOAD_CRC_POS] = calculate_crc(payload, IPI_W0_TO_W6_SIZE);
 #endif
@@ -74,6 +197,29 @@ static enum pm_ret_status pm_ipi_send_common(const struct pm_proc *proc,
 	return PM_RET_SUCCESS;
 }
 
+/**
+ * pm_ipi_wait_idle() - Waits for the remote processor to handle the last
+ *			request sent through the IPI channel of a processor
+ * @proc	Pointer to the processor who initiated the request
+ *
+ * @return	Returns PM_RET_SUCCESS, or PM_RET_ERROR_TIMEOUT if the request
+ *		is still pending after PM_IPI_IDLE_TIMEOUT_US
+ */
+enum pm_ret_status pm_ipi_wait_idle(const struct pm_proc *proc)
+{
+	uint64_t timeout = timeout_init_us(PM_IPI_IDLE_TIMEOUT_US);
+
+	while ((ipi_mb_enquire_status(proc->ipi->local_ipi_id,
+				      proc->ipi->remote_ipi_id) &
+		IPI_MB_STATUS_SEND_PENDING) != 0) {
+		if (timeout_elapsed(timeout)) {
+			return PM_RET_ERROR_TIMEOUT;
+		}
+	}
+
+	return PM_RET_SUCCESS;
+}
+
 /**
  * pm_ipi_send_non_blocking() - Sends IPI request to the remote processor
  *			        without blocking notification
@@ -238,6 +384,150 @@ unlock:
 	return ret;
 }
 
+/**
+ * pm_ipi_send_yield() - Sends IPI request to the remote processor without
+ *			 waiting for it to be handled
+ * @proc	Pointer to the processor who is initiating request
+ * @payload	API id and call arguments to be written in IPI buffer
+ * @sec_state	Security state of the caller initiating the request
+ * @token	Used to return the token identifying the request. Only a
+ *		caller presenting this token from the same security state can
+ *		collect its response or abort it, whichever core it runs on.
+ *
+ * Only one such request can be in flight at a time. Its completion is
+ * checked with pm_ipi_yield_poll(), which must be called until it reports
+ * the request as done, unless the request is aborted with
+ * pm_ipi_yield_abort(). A request whose owner has not polled it for
+ * PM_IPI_YIELD_TIMEOUT_US is aborted when another one is sent.
+ *
+ * @return	Returns status, either success or error+reason
+ */
+enum pm_ret_status pm_ipi_send_yield(const struct pm_proc *proc,
+				     uint32_t payload[PAYLOAD_ARG_CNT],
+				     uint32_t sec_state, uint32_t *token)
+{
+	enum pm_ret_status ret = PM_RET_ERROR_CONFLICT;
+
+	bakery_lock_get(&pm_secure_lock);
+
+	if ((pm_ipi_yield.state != PM_IPI_YIELD_IDLE) &&
+	    timeout_elapsed(pm_ipi_yield.expire)) {
+		WARN("Stale yielding PM request 0x%x aborted\n",
+		     pm_ipi_yield.api_id);
+		pm_ipi_yield.state = (pm_ipi_yield.state == PM_IPI_YIELD_DONE) ?
+				     PM_IPI_YIELD_IDLE : PM_IPI_YIELD_ABORTED;
+	}
+
+	if (!pm_ipi_yield_collect() &&
+	    (pm_ipi_yield.state == PM_IPI_YIELD_IDLE)) {
+		ret = pm_ipi_send_common(proc, payload, IPI_NON_BLOCKING);
+		if (ret == PM_RET_SUCCESS) {
+			/* Tokens are never 0, so that 0 matches no request */
+			pm_ipi_yield.last_token++;
+			if (pm_ipi_yield.last_token == 0U) {
+				pm_ipi_yield.last_token++;
+			}
+
+			pm_ipi_yield.proc = proc;
+			pm_ipi_yield.token = pm_ipi_yield.last_token;
+			pm_ipi_yield.sec_state = sec_state;
+			*token = pm_ipi_yield.token;
+			pm_ipi_yield.api_id = payload[0];
+			pm_ipi_yield.expire =
+				timeout_init_us(PM_IPI_YIELD_TIMEOUT_US);
+			pm_ipi_yield.state = PM_IPI_YIELD_PENDING;
+		}
+	}
+
+	bakery_lock_release(&pm_secure_lock);
+
+	return ret;
+}
+
+/**
+ * pm_ipi_yield_poll() - Checks whether the request sent by
+ *			 pm_ipi_send_yield() has been handled
+ * @token	Token returned by pm_ipi_send_yield()
+ * @sec_state	Security state of the caller
+ * @api_id	Used to return the API id of the request
+ * @status	Used to return the status of the request once handled
+ * @value	Used to return value from IPI buffer element (optional)
+ * @count	Number of values to return in @value
+ *
+ * Once the request is reported as handled, a new one can be sent. If no
+ * request is in flight, it is reported as handled with an error status, and
+ * if the token or the security state does not match the request, with an
+ * access error.
+ *
+ * @return	Returns true if the request has been handled, false otherwise
+ */
+bool pm_ipi_yield_poll(uint32_t token, uint32_t sec_state, uint32_t *api_id,
+		       enum pm_ret_status *status, unsigned int *value,
+		       size_t count)
+{
+	bool done = true;
+	size_t i;
+
+	bakery_lock_get(&pm_secure_lock);
+
+	*api_id = pm_ipi_yield.api_id;
+
+	if ((pm_ipi_yield.state != PM_IPI_YIELD_PENDING) &&
+	    (pm_ipi_yield.state != PM_IPI_YIELD_DONE)) {
+		*status = PM_RET_ERROR_ARGS;
+	} else if ((pm_ipi_yield.token != token) ||
+		   (pm_ipi_yield.sec_state != sec_state)) {
+		*status = PM_RET_ERROR_ACCESS;
+	} else if (pm_ipi_yield_collect()) {
+		pm_ipi_yield.expire = timeout_init_us(PM_IPI_YIELD_TIMEOUT_US);
+		done = false;
+	} else {
+		for (i = 0; (i < count) && (i < (PAYLOAD_ARG_CNT - 1U)); i++)
+			value[i] = pm_ipi_yield.response[i + 1U];
+
+		*status = ERROR_CODE_MASK & pm_ipi_yield.response[0];
+		pm_ipi_yield.state = PM_IPI_YIELD_IDLE;
+	}
+
+	bakery_lock_release(&pm_secure_lock);
+
+	return done;
+}
+
+/**
+ * pm_ipi_yield_abort() - Aborts the request sent by pm_ipi_send_yield()
+ * @token	Token returned by pm_ipi_send_yield()
+ * @sec_state	Security state of the caller
+ *
+ * The remote processor cannot be interrupted, the request keeps running but
+ * its response is discarded. A new request can be sent once it has been
+ * handled.
+ *
+ * @return	Returns status, either success or error+reason
+ */
+enum pm_ret_status pm_ipi_yield_abort(uint32_t token, uint32_t sec_state)
+{
+	enum pm_ret_status ret = PM_RET_SUCCESS;
+
+	bakery_lock_get(&pm_secure_lock);
+
+	if ((pm_ipi_yield.state != PM_IPI_YIELD_PENDING) &&
+	    (pm_ipi_yield.state != PM_IPI_YIELD_DONE)) {
+		ret = PM_RET_ERROR_ARGS;
+	} else if ((pm_ipi_yield.token != token) ||
+		   (pm_ipi_yield.sec_state != sec_state)) {
+		ret = PM_RET_ERROR_ACCESS;
+	} else if (pm_ipi_yield.state == PM_IPI_YIELD_DONE) {
+		pm_ipi_yield.state = PM_IPI_YIELD_IDLE;
+	} else {
+		pm_ipi_yield.state = PM_IPI_YIELD_ABORTED;
+	}
+
+	bakery_lock_release(&pm_secure_lock);
+
+	return ret;
+}
+
 void pm_ipi_irq_enable(const struct pm_proc *proc)
 {
 	ipi_mb_enable_irq(proc->ipi->local_ipi_id, proc->ipi->remote_ipi_id);
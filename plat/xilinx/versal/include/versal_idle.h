@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2022, Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef VERSAL_IDLE_H
+#define VERSAL_IDLE_H
+
+#include <stdint.h>
+
+#include <lib/psci/psci.h>
+#include <lib/utils_def.h>
+
+#include <platform_def.h>
+
+/* Local power states of the APU core and cluster power domains */
+#define VERSAL_LOCAL_STATE_RUN		PSCI_LOCAL_STATE_RUN
+#define VERSAL_LOCAL_STATE_RET		PLAT_MAX_RET_STATE
+#define VERSAL_LOCAL_STATE_OFF		PLAT_MAX_OFF_STATE
+
+/*
+ * PSCI state id of an idle state: local state of the core in bits [3:0] and
+ * of the cluster in bits [7:4]. State id 0 is kept for compatibility and
+ * selects the core retention or core power down state depending on the
+ * state type.
+ */
+#define VERSAL_IDLE_STATE_ID(_core, _cluster)	((_core) | ((_cluster) << 4))
+
+/* PMC state of an idle state that is entered without the PMC */
+#define VERSAL_IDLE_NO_PMC		U(0xFFFFFFFF)
+
+/*
+ * Exit latency and minimum residency of the idle states, in microseconds.
+ * Platforms override them with the values measured on their board.
+ */
+#ifndef VERSAL_IDLE_CORE_RET_EXIT_LATENCY
+#define VERSAL_IDLE_CORE_RET_EXIT_LATENCY	U(1)
+#endif
+#ifndef VERSAL_IDLE_CORE_RET_MIN_RESIDENCY
+#define VERSAL_IDLE_CORE_RET_MIN_RESIDENCY	U(1)
+#endif
+#ifndef VERSAL_IDLE_CORE_OFF_EXIT_LATENCY
+#define VERSAL_IDLE_CORE_OFF_EXIT_LATENCY	U(400)
+#endif
+#ifndef VERSAL_IDLE_CORE_OFF_MIN_RESIDENCY
+#define VERSAL_IDLE_CORE_OFF_MIN_RESIDENCY	U(1000)
+#endif
+#ifndef VERSAL_IDLE_CLUSTER_OFF_EXIT_LATENCY
+#define VERSAL_IDLE_CLUSTER_OFF_EXIT_LATENCY	U(1500)
+#endif
+#ifndef VERSAL_IDLE_CLUSTER_OFF_MIN_RESIDENCY
+#define VERSAL_IDLE_CLUSTER_OFF_MIN_RESIDENCY	U(5000)
+#endif
+
+/* Return codes of the idle state SiP call */
+#define VERSAL_IDLE_SUCCESS		0
+#define VERSAL_IDLE_INVALID_PARAM	-2
+
+/*
+ * versal_idle_state - Description of an idle state
+ * @state_id		PSCI state id, see VERSAL_IDLE_STATE_ID()
+ * @core_state		Local state of the core
+ * @cluster_state	Local state of the cluster
+ * @pmc_state		PM_STATE_* requested to the PMC, or VERSAL_IDLE_NO_PMC
+ * @exit_latency	Exit latency in microseconds
+ * @min_residency	Minimum residency in microseconds
+ */
+struct versal_idle_state {
+	uint32_t state_id;
+	uint8_t core_state;
+	uint8_t cluster_state;
+	uint32_t pmc_state;
+	uint32_t exit_latency;
+	uint32_t min_residency;
+};
+
+const struct versal_idle_state *versal_idle_get_state(unsigned int power_state);
+const struct versal_idle_state *versal_idle_find_state(
+				const psci_power_state_t *target_state);
+uintptr_t versal_idle_smc_handler(u_register_t x1, void *handle);
+
+#endif /* VERSAL_IDLE_H */
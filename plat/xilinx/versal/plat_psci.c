@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,6 +16,8 @@
 
 #include "pm_api_sys.h"
 #include "pm_client.h"
+#include "pm_ipi.h"
+#include <versal_idle.h>
 
 static uintptr_t versal_sec_entry;
 
@@ -43,37 +45,66 @@ static int versal_pwr_domain_on(u_register_t mpidr)
 }
 
 /**
- * versal_pwr_domain_suspend() - This function sends request to PMC to suspend
- * core.
+ * versal_cpu_standby() - This function enters core retention locally, without
+ * involving the PMC and keeping the GIC CPU interface enabled.
+ *
+ * @cpu_state	Target local state of the core
+ */
+static void versal_cpu_standby(plat_local_state_t cpu_state)
+{
+	u_register_t scr = read_scr_el3();
+
+	assert(cpu_state == VERSAL_LOCAL_STATE_RET);
+
+	/* Route physical IRQs to EL3 so that they wake up the core */
+	write_scr_el3(scr | SCR_IRQ_BIT);
+	isb();
+	dsb();
+	wfi();
+
+	write_scr_el3(scr);
+}
+
+/**
+ * versal_pwr_domain_suspend() - This function posts the request to suspend
+ * the core to the PMC.
  *
  * @target_state	Targated state
  */
 static void versal_pwr_domain_suspend(const psci_power_state_t *target_state)
 {
-	unsigned int state;
 	unsigned int cpu_id = plat_my_core_pos();
 	const struct pm_proc *proc = pm_get_proc(cpu_id);
+	const struct versal_idle_state *state;
 
 	for (size_t i = 0U; i <= PLAT_MAX_PWR_LVL; i++) {
 		VERBOSE("%s: target_state->pwr_domain_state[%lu]=%x\n",
 			__func__, i, target_state->pwr_domain_state[i]);
 	}
 
+	state = versal_idle_find_state(target_state);
+	assert(state != NULL);
+
+	/* Retention states are entered without the PMC */
+	if (state->pmc_state == VERSAL_IDLE_NO_PMC) {
+		return;
+	}
+
 	plat_versal_gic_cpuif_disable();
 
-	if (target_state->pwr_domain_state[1] > PLAT_MAX_RET_STATE) {
+	if (state->cluster_state == VERSAL_LOCAL_STATE_OFF) {
 		plat_versal_gic_save();
 	}
 
-	state = target_state->pwr_domain_state[1] > PLAT_MAX_RET_STATE ?
-		PM_STATE_SUSPEND_TO_RAM : PM_STATE_CPU_IDLE;
-
-	/* Send request to PMC to suspend this core */
-	(void)pm_self_suspend(proc->node_id, MAX_LATENCY, state, versal_sec_entry,
-			SECURE_FLAG);
+	/*
+	 * Post the request to the PMC, which suspends this core once it has
+	 * entered WFI.
+	 */
+	(void)pm_self_suspend_post(proc->node_id, MAX_LATENCY, state->pmc_state,
+				   versal_sec_entry, SECURE_FLAG);
 
 	/* APU is to be turned off */
-	if (target_state->pwr_domain_state[1] > PLAT_MAX_RET_STATE) {
+	if (state->cluster_state == VERSAL_LOCAL_STATE_OFF) {
 		/* disable coherency */
 		plat_arm_interconnect_exit_coherency();
 	}
@@ -90,12 +121,30 @@ static void versal_pwr_domain_suspend_finish(
 {
 	unsigned int cpu_id = plat_my_core_pos();
 	const struct pm_proc *proc = pm_get_proc(cpu_id);
+	const struct versal_idle_state *state;
 
 	for (size_t i = 0U; i <= PLAT_MAX_PWR_LVL; i++) {
 		VERBOSE("%s: target_state->pwr_domain_state[%lu]=%x\n",
 			__func__, i, target_state->pwr_domain_state[i]);
 	}
 
+	state = versal_idle_find_state(target_state);
+	assert(state != NULL);
+
+	/* The GIC was retained */
+	if (state->pmc_state == VERSAL_IDLE_NO_PMC) {
+		return;
+	}
+
+	/*
+	 * The core may have been woken up before the PMC handled the posted
+	 * suspend request, wait for it before clearing the power down request.
+	 */
+	if (pm_ipi_wait_idle(proc) != PM_RET_SUCCESS) {
+		WARN("PMC did not handle the suspend request of core %u\n",
+		     cpu_id);
+	}
+
 	/* Clear the APU power control register for this cpu */
 	pm_client_wakeup(proc);
 
@@ -103,7 +152,7 @@ static void versal_pwr_domain_suspend_finish(
 	plat_arm_interconnect_enter_coherency();
 
 	/* APU was turned off, so restore GIC context */
-	if (target_state->pwr_domain_state[1] > PLAT_MAX_RET_STATE) {
+	if (state->cluster_state == VERSAL_LOCAL_STATE_OFF) {
 		plat_versal_gic_resume();
 	}
 
@@ -191,24 +240,21 @@ static void versal_pwr_domain_off(const psci_power_state_t *target_state)
 static int versal_validate_power_state(unsigned int power_state,
 				       psci_power_state_t *req_state)
 {
-	VERBOSE("%s: power_state: 0x%x\n", __func__, power_state);
+	const struct versal_idle_state *state;
 
-	unsigned int pstate = psci_get_pstate_type(power_state);
+	VERBOSE("%s: power_state: 0x%x\n", __func__, power_state);
 
 	assert(req_state);
 
 	/* Sanity check the requested state */
-	if (pstate == PSTATE_TYPE_STANDBY) {
-		req_state->pwr_domain_state[MPIDR_AFFLVL0] = PLAT_MAX_RET_STATE;
-	} else {
-		req_state->pwr_domain_state[MPIDR_AFFLVL0] = PLAT_MAX_OFF_STATE;
-	}
-
-	/* We expect the 'state id' to be zero */
-	if (psci_get_pstate_id(power_state) != 0U) {
+	state = versal_idle_get_state(power_state);
+	if (state == NULL) {
 		return PSCI_E_INVALID_PARAMS;
 	}
 
+	req_state->pwr_domain_state[MPIDR_AFFLVL0] = state->core_state;
+	req_state->pwr_domain_state[MPIDR_AFFLVL1] = state->cluster_state;
+
 	return PSCI_E_SUCCESS;
 }
 
@@ -224,6 +270,7 @@ static void versal_get_sys_suspend_power_state(psci_power_state_t *req_state)
 }
 
 static const struct plat_psci_ops versal_nopmc_psci_ops = {
+	.cpu_standby			= versal_cpu_standby,
 	.pwr_domain_on			= versal_pwr_domain_on,
 	.pwr_domain_off			= versal_pwr_domain_off,
 	.pwr_domain_on_finish		= versal_pwr_domain_on_finish,
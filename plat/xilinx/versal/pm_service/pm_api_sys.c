@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Xilinx, Inc. All rights reserved.
+ * Copyright (c) 2019-2022, Xilinx, Inc. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -99,6 +99,44 @@ enum pm_ret_status pm_self_suspend(uint32_t nid,
 	return pm_ipi_send_sync(proc, payload, NULL, 0);
 }
 
+/**
+ * pm_self_suspend_post() - PM call for processor to suspend itself, without
+ *			    waiting for the PMC
+ * @nid		Node id of the processor or subsystem
+ * @latency	Requested maximum wakeup latency (not supported)
+ * @state	Requested state
+ * @address	Resume address
+ * @flag	0 - Call from secure source
+ *		1 - Call from non-secure source
+ *
+ * Same as pm_self_suspend(), but the request is only posted to the PMC, which
+ * handles it while the processor enters WFI. The next request sent through
+ * the IPI channel waits for this one to be handled.
+ *
+ * @return	Returns status, either success or error+reason
+ */
+enum pm_ret_status pm_self_suspend_post(uint32_t nid,
+					unsigned int latency,
+					unsigned int state,
+					uintptr_t address, uint32_t flag)
+{
+	uint32_t payload[PAYLOAD_ARG_CNT];
+	unsigned int cpuid = plat_my_core_pos();
+	const struct pm_proc *proc = pm_get_proc(cpuid);
+
+	if (proc == NULL) {
+		WARN("Failed to get proc %d\n", cpuid);
+		return PM_RET_ERROR_INTERNAL;
+	}
+
+	pm_client_suspend(proc, state);
+
+	PM_PACK_PAYLOAD6(payload, LIBPM_MODULE_ID, flag, PM_SELF_SUSPEND,
+			 proc->node_id, latency, state, address,
+			 (address >> 32));
+	return pm_ipi_send_non_blocking(proc, payload);
+}
+
 /**
  * pm_abort_suspend() - PM call to announce that a prior suspend request
  *			is to be aborted.
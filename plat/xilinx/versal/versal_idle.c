@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2022, Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Table driven description of the APU idle states.
+ *
+ * Core retention is entered locally with WFI, leaving the GIC untouched and
+ * without involving the PMC. The power down states are requested to the PMC,
+ * which powers down the core, or the whole APU cluster, once it is in WFI.
+ */
+
+#include <stddef.h>
+
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/psci/psci.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+#include "pm_defs.h"
+#include <versal_idle.h>
+
+#if !PSCI_EXTENDED_STATE_ID
+#error "Versal idle states require PSCI_EXTENDED_STATE_ID"
+#endif
+
+/* Ordered from the shallowest to the deepest state */
+static const struct versal_idle_state versal_idle_states[] = {
+	{
+		.state_id = VERSAL_IDLE_STATE_ID(VERSAL_LOCAL_STATE_RET,
+						 VERSAL_LOCAL_STATE_RUN),
+		.core_state = VERSAL_LOCAL_STATE_RET,
+		.cluster_state = VERSAL_LOCAL_STATE_RUN,
+		.pmc_state = VERSAL_IDLE_NO_PMC,
+		.exit_latency = VERSAL_IDLE_CORE_RET_EXIT_LATENCY,
+		.min_residency = VERSAL_IDLE_CORE_RET_MIN_RESIDENCY,
+	},
+	{
+		.state_id = VERSAL_IDLE_STATE_ID(VERSAL_LOCAL_STATE_OFF,
+						 VERSAL_LOCAL_STATE_RUN),
+		.core_state = VERSAL_LOCAL_STATE_OFF,
+		.cluster_state = VERSAL_LOCAL_STATE_RUN,
+		.pmc_state = PM_STATE_CPU_IDLE,
+		.exit_latency = VERSAL_IDLE_CORE_OFF_EXIT_LATENCY,
+		.min_residency = VERSAL_IDLE_CORE_OFF_MIN_RESIDENCY,
+	},
+	{
+		.state_id = VERSAL_IDLE_STATE_ID(VERSAL_LOCAL_STATE_OFF,
+						 VERSAL_LOCAL_STATE_OFF),
+		.core_state = VERSAL_LOCAL_STATE_OFF,
+		.cluster_state = VERSAL_LOCAL_STATE_OFF,
+		.pmc_state = PM_STATE_SUSPEND_TO_RAM,
+		.exit_latency = VERSAL_IDLE_CLUSTER_OFF_EXIT_LATENCY,
+		.min_residency = VERSAL_IDLE_CLUSTER_OFF_MIN_RESIDENCY,
+	},
+};
+
+static unsigned int versal_idle_state_type(const struct versal_idle_state *s)
+{
+	return (s->core_state == VERSAL_LOCAL_STATE_OFF) ?
+		PSTATE_TYPE_POWERDOWN : PSTATE_TYPE_STANDBY;
+}
+
+/**
+ * versal_idle_get_state() - Returns the idle state requested by a CPU_SUSPEND
+ *			     power_state parameter
+ * @power_state		Power state parameter
+ *
+ * @return	Idle state, or NULL if the parameter is invalid
+ */
+const struct versal_idle_state *versal_idle_get_state(unsigned int power_state)
+{
+	unsigned int type = psci_get_pstate_type(power_state);
+	unsigned int id = psci_get_pstate_id(power_state);
+
+	if (id == 0U) {
+		id = (type == PSTATE_TYPE_STANDBY) ?
+			VERSAL_IDLE_STATE_ID(VERSAL_LOCAL_STATE_RET,
+					     VERSAL_LOCAL_STATE_RUN) :
+			VERSAL_IDLE_STATE_ID(VERSAL_LOCAL_STATE_OFF,
+					     VERSAL_LOCAL_STATE_RUN);
+	}
+
+	for (size_t i = 0U; i < ARRAY_SIZE(versal_idle_states); i++) {
+		const struct versal_idle_state *s = &versal_idle_states[i];
+
+		if ((s->state_id == id) && (versal_idle_state_type(s) == type)) {
+			return s;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * versal_idle_find_state() - Returns the idle state matching the coordinated
+ *			      target state of the calling core
+ * @target_state	Target state
+ *
+ * @return	Idle state, or NULL if no state matches
+ */
+const struct versal_idle_state *versal_idle_find_state(
+				const psci_power_state_t *target_state)
+{
+	for (size_t i = 0U; i < ARRAY_SIZE(versal_idle_states); i++) {
+		const struct versal_idle_state *s = &versal_idle_states[i];
+
+		if ((s->core_state ==
+		     target_state->pwr_domain_state[MPIDR_AFFLVL0]) &&
+		    (s->cluster_state ==
+		     target_state->pwr_domain_state[MPIDR_AFFLVL1])) {
+			return s;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * versal_idle_smc_handler() - Returns the description of an idle state
+ * @x1		Index of the idle state, from the shallowest to the deepest
+ * @handle	Pointer to caller's context structure
+ *
+ * Returns the CPU_SUSPEND power_state parameter of the idle state, its exit
+ * latency and its minimum residency, so that the OS can choose the idle
+ * states to use.
+ */
+uintptr_t versal_idle_smc_handler(u_register_t x1, void *handle)
+{
+	const struct versal_idle_state *s;
+
+	if (x1 >= ARRAY_SIZE(versal_idle_states)) {
+		SMC_RET1(handle, VERSAL_IDLE_INVALID_PARAM);
+	}
+
+	s = &versal_idle_states[x1];
+
+	SMC_RET4(handle, VERSAL_IDLE_SUCCESS,
+		 (versal_idle_state_type(s) << PSTATE_TYPE_SHIFT) | s->state_id,
+		 s->exit_latency, s->min_residency);
+}
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2013-2021, ARM Limited and Contributors. All rights reserved.
+# Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 
@@ -9,6 +9,7 @@ PSCI_EXTENDED_STATE_ID := 1
 A53_DISABLE_NON_TEMPORAL_HINT := 0
 SEPARATE_CODE_AND_RODATA := 1
 ZYNQMP_WDT_RESTART := 0
+ZYNQMP_SIP_YIELD := 0
 IPI_CRC_CHECK := 0
 override RESET_TO_BL31 := 1
 override WARMBOOT_ENABLE_DCACHE_EARLY := 1
@@ -61,6 +62,9 @@ ifdef ZYNQMP_WDT_RESTART
     $(eval $(call add_define,ZYNQMP_WDT_RESTART))
 endif
 
+$(eval $(call assert_boolean,ZYNQMP_SIP_YIELD))
+$(eval $(call add_define,ZYNQMP_SIP_YIELD))
+
 ifdef ZYNQMP_IPI_CRC_CHECK
     $(warning "ZYNQMP_IPI_CRC_CHECK macro is deprecated...instead please use IPI_CRC_CHECK.")
 endif
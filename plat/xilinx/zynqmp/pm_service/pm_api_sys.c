@@ -1557,6 +1557,43 @@ enum pm_ret_status pm_secure_image(uint32_t address_low,
 	return pm_ipi_send_sync(primary_proc, payload, value, 2);
 }
 
+#if ZYNQMP_SIP_YIELD
+/**
+ * pm_yield_start() - Start a long-running request without waiting for the
+ *		      PMU to handle it
+ * @api_id	PM_FPGA_LOAD, PM_SECURE_RSA_AES or PM_SECURE_IMAGE
+ * @arg		Call arguments, in the order taken by pm_fpga_load(),
+ *		pm_secure_rsaaes() and pm_secure_image()
+ * @sec_state	Security state of the caller
+ * @token	Used to return the token identifying the request
+ *
+ * Completion is checked with pm_ipi_yield_poll().
+ *
+ * @return	Returns status, either success or error+reason
+ */
+enum pm_ret_status pm_yield_start(uint32_t api_id, const uint32_t *arg,
+				  uint32_t sec_state, uint32_t *token)
+{
+	uint32_t payload[PAYLOAD_ARG_CNT];
+
+	switch (api_id) {
+	case PM_FPGA_LOAD:
+	case PM_SECURE_RSA_AES:
+		PM_PACK_PAYLOAD5(payload, api_id, arg[1], arg[0], arg[2],
+				 arg[3]);
+		break;
+	case PM_SECURE_IMAGE:
+		PM_PACK_PAYLOAD5(payload, api_id, arg[1], arg[0], arg[3],
+				 arg[2]);
+		break;
+	default:
+		return PM_RET_ERROR_ARGS;
+	}
+
+	return pm_ipi_send_yield(primary_proc, payload, sec_state, token);
+}
+#endif /* ZYNQMP_SIP_YIELD */
+
 /**
  * pm_fpga_read - Perform the fpga configuration readback
  *
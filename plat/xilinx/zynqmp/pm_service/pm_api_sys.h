@@ -207,6 +207,10 @@ enum pm_ret_status pm_secure_image(uint32_t address_low,
 				   uint32_t key_lo,
 				   uint32_t key_hi,
 				   uint32_t *value);
+#if ZYNQMP_SIP_YIELD
+enum pm_ret_status pm_yield_start(uint32_t api_id, const uint32_t *arg,
+				  uint32_t sec_state, uint32_t *token);
+#endif
 enum pm_ret_status pm_fpga_read(uint32_t reg_numframes,
 				uint32_t address_low,
 				uint32_t address_high,
@@ -12,6 +12,10 @@
 #include <errno.h>
 
 #include <common/runtime_svc.h>
+#if ZYNQMP_SIP_YIELD
+#include <bl31/interrupt_mgmt.h>
+#include <plat/common/platform.h>
+#endif
 #if ZYNQMP_WDT_RESTART
 #include <arch_helpers.h>
 #include <drivers/arm/gicv2.h>
@@ -612,3 +616,143 @@ uint64_t em_smc_handler(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3,
 		SMC_RET1(handle, SMC_UNK);
 	}
 }
+
+#if ZYNQMP_SIP_YIELD
+/**
+ * pm_yield_sec_state() - Security state of the caller of a yielding PM-API
+ *			  call
+ * @flags - Flags of the SMC
+ *
+ * A yielding request can only be resumed or aborted from the security state
+ * it was started from. The caller may have been migrated to another core in
+ * the meantime, so the core is not checked.
+ */
+static uint32_t pm_yield_sec_state(uint64_t flags)
+{
+	return is_caller_secure(flags) ? SECURE : NON_SECURE;
+}
+
+/**
+ * pm_yield_wait() - Wait for the yielding PM request in flight to complete
+ * @handle - Pointer to caller's context structure
+ * @token - Token identifying the request
+ * @sec_state - Security state of the caller
+ *
+ * Polls the PMU for the completion of the request while checking for pending
+ * interrupts. If an interrupt is pending, the call returns SMC_PREEMPTED and
+ * the token of the request so that the caller can service it; the request
+ * keeps running on the PMU and its completion is collected by a later ZynqMP
+ * yield resume call presenting the token.
+ */
+static uint64_t pm_yield_wait(void *handle, uint32_t token, uint32_t sec_state)
+{
+	enum pm_ret_status ret;
+	uint32_t result[PAYLOAD_ARG_CNT] = {0};
+	uint32_t api_id;
+
+	while (!pm_ipi_yield_poll(token, sec_state, &api_id, &ret, result,
+				  2)) {
+		if (plat_ic_get_pending_interrupt_type() != INTR_TYPE_INVAL)
+			SMC_RET2(handle, SMC_PREEMPTED, token);
+	}
+
+	if (api_id == PM_SECURE_IMAGE)
+		SMC_RET2(handle, (uint64_t)ret | ((uint64_t)result[0] << 32),
+			 result[1]);
+
+	SMC_RET1(handle, (uint64_t)ret);
+}
+
+/**
+ * pm_yield_smc_handler() - Yielding SMC handler for long-running PM-API calls
+ * @smc_fid - Function Identifier
+ * @x1 - x4 - Arguments
+ * @cookie  - Unused
+ * @handler - Pointer to caller's context structure
+ *
+ * @return  - Unused
+ *
+ * Starts PM_FPGA_LOAD, PM_SECURE_RSA_AES and PM_SECURE_IMAGE requests without
+ * masking interrupts for their whole duration. Arguments and return values
+ * are the same as for the fast SMC variant, except that SMC_PREEMPTED can be
+ * returned along with a token in x1, in which case the request must be
+ * resumed or aborted with this token. Only one
+ * yielding request can be in flight at a time.
+ */
+uint64_t pm_yield_smc_handler(uint32_t smc_fid, uint64_t x1, uint64_t x2,
+			      uint64_t x3, uint64_t x4, void *cookie,
+			      void *handle, uint64_t flags)
+{
+	enum pm_ret_status ret;
+	uint32_t pm_arg[4];
+	uint32_t sec_state;
+	uint32_t token;
+
+	if (!pm_up)
+		SMC_RET1(handle, SMC_UNK);
+
+	pm_arg[0] = (uint32_t)x1;
+	pm_arg[1] = (uint32_t)(x1 >> 32);
+	pm_arg[2] = (uint32_t)x2;
+	pm_arg[3] = (uint32_t)(x2 >> 32);
+
+	sec_state = pm_yield_sec_state(flags);
+
+	switch (smc_fid & FUNCID_NUM_MASK) {
+	case PM_FPGA_LOAD:
+	case PM_SECURE_RSA_AES:
+	case PM_SECURE_IMAGE:
+		ret = pm_yield_start(smc_fid & FUNCID_NUM_MASK, pm_arg,
+				     sec_state, &token);
+		if (ret != PM_RET_SUCCESS)
+			SMC_RET1(handle, (uint64_t)ret);
+
+		return pm_yield_wait(handle, token, sec_state);
+
+	default:
+		WARN("Unimplemented PM Yielding Service Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+}
+
+/**
+ * pm_yield_resume() - Resume the wait for a preempted yielding PM-API call
+ * @x1 - Token returned with SMC_PREEMPTED
+ * @handle - Pointer to caller's context structure
+ * @flags - Flags of the SMC
+ *
+ * @return  - Unused
+ */
+uint64_t pm_yield_resume(uint64_t x1, void *handle, uint64_t flags)
+{
+	if (!pm_up)
+		SMC_RET1(handle, SMC_UNK);
+
+	if (x1 > UINT32_MAX)
+		SMC_RET1(handle, (uint64_t)PM_RET_ERROR_ARGS);
+
+	return pm_yield_wait(handle, (uint32_t)x1, pm_yield_sec_state(flags));
+}
+
+/**
+ * pm_yield_abort() - Abort a preempted yielding PM-API call
+ * @x1 - Token returned with SMC_PREEMPTED
+ * @handle - Pointer to caller's context structure
+ * @flags - Flags of the SMC
+ *
+ * The PMU keeps handling the request, but its result is discarded.
+ *
+ * @return  - Unused
+ */
+uint64_t pm_yield_abort(uint64_t x1, void *handle, uint64_t flags)
+{
+	if (!pm_up)
+		SMC_RET1(handle, SMC_UNK);
+
+	if (x1 > UINT32_MAX)
+		SMC_RET1(handle, (uint64_t)PM_RET_ERROR_ARGS);
+
+	SMC_RET1(handle, (uint64_t)pm_ipi_yield_abort((uint32_t)x1,
+						      pm_yield_sec_state(flags)));
+}
+#endif /* ZYNQMP_SIP_YIELD */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,4 +17,12 @@ uint64_t pm_smc_handler(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3,
 uint64_t em_smc_handler(uint32_t smc_fid, uint64_t x1, uint64_t x2, uint64_t x3,
 			uint64_t x4, void *cookie, void *handle,
 			uint64_t flags);
+
+#if ZYNQMP_SIP_YIELD
+uint64_t pm_yield_smc_handler(uint32_t smc_fid, uint64_t x1, uint64_t x2,
+			      uint64_t x3, uint64_t x4, void *cookie,
+			      void *handle, uint64_t flags);
+uint64_t pm_yield_resume(uint64_t x1, void *handle, uint64_t flags);
+uint64_t pm_yield_abort(uint64_t x1, void *handle, uint64_t flags);
+#endif
 #endif /* PM_SVC_MAIN_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,6 +17,10 @@
 #define ZYNQMP_SIP_SVC_UID		0x8200ff01
 #define ZYNQMP_SIP_SVC_VERSION		0x8200ff03
 
+/* Yielding SMC function IDs resuming or aborting a preempted PM call */
+#define ZYNQMP_SIP_SVC_YIELD_RESUME	0x0200ff10
+#define ZYNQMP_SIP_SVC_YIELD_ABORT	0x0200ff11
+
 /* SiP Service Calls version numbers */
 #define SIP_SVC_VERSION_MAJOR	0
 #define SIP_SVC_VERSION_MINOR	1
@@ -103,3 +107,44 @@ DECLARE_RT_SVC(
 		SMC_TYPE_FAST,
 		sip_svc_setup,
 		sip_svc_smc_handler);
+
+#if ZYNQMP_SIP_YIELD
+/**
+ * sip_svc_yield_smc_handler() - Top-level SiP Service yielding SMC handler
+ *
+ * Handler for the yielding SiP SMC calls, used by long-running PM-API
+ * functions which must not keep interrupts masked until they complete.
+ */
+static uintptr_t sip_svc_yield_smc_handler(uint32_t smc_fid,
+					   u_register_t x1,
+					   u_register_t x2,
+					   u_register_t x3,
+					   u_register_t x4,
+					   void *cookie,
+					   void *handle,
+					   u_register_t flags)
+{
+	if (smc_fid == ZYNQMP_SIP_SVC_YIELD_RESUME)
+		return pm_yield_resume(x1, handle, flags);
+
+	if (smc_fid == ZYNQMP_SIP_SVC_YIELD_ABORT)
+		return pm_yield_abort(x1, handle, flags);
+
+	if (is_pm_fid(smc_fid)) {
+		return pm_yield_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					    handle, flags);
+	}
+
+	WARN("Unimplemented SiP Service Call: 0x%x\n", smc_fid);
+	SMC_RET1(handle, SMC_UNK);
+}
+
+/* Register yielding PM Service Calls as runtime service */
+DECLARE_RT_SVC(
+		sip_svc_yield,
+		OEN_SIP_START,
+		OEN_SIP_END,
+		SMC_TYPE_YIELD,
+		NULL,
+		sip_svc_yield_smc_handler);
+#endif /* ZYNQMP_SIP_YIELD */
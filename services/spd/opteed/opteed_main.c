@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -98,6 +98,9 @@ static int32_t opteed_setup(void)
 	uint64_t opteed_pageable_part;
 	uint64_t opteed_mem_limit;
 	uint64_t dt_addr;
+#if OPTEE_PAGEABLE_HASHES
+	uint64_t pageable_hashes;
+#endif
 
 	linear_id = plat_my_core_pos();
 
@@ -126,6 +129,9 @@ static int32_t opteed_setup(void)
 	opteed_pageable_part = optee_ep_info->args.arg1;
 	opteed_mem_limit = optee_ep_info->args.arg2;
 	dt_addr = optee_ep_info->args.arg3;
+#if OPTEE_PAGEABLE_HASHES
+	pageable_hashes = optee_ep_info->args.arg4;
+#endif
 
 	opteed_init_optee_ep_state(optee_ep_info,
 				opteed_rw,
@@ -135,6 +141,14 @@ static int32_t opteed_setup(void)
 				dt_addr,
 				&opteed_sp_context[linear_id]);
 
+#if OPTEE_PAGEABLE_HASHES
+	/*
+	 * Pass the table of hashes of the pageable image computed by BL2, if
+	 * any, to OP-TEE in x3.
+	 */
+	optee_ep_info->args.arg3 = pageable_hashes;
+#endif
+
 	/*
 	 * All OPTEED initialization done. Now register our init function with
 	 * BL31 for deferred invocation
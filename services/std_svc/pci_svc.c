@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2021-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,10 +9,19 @@
 
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/utils_def.h>
 #include <services/pci_svc.h>
 #include <services/std_svc.h>
 #include <smccc_helpers.h>
 
+#include <platform_def.h>
+
+#if SMC_PCI_BATCH
+#if !defined(PLAT_PCI_BATCH_NS_BUF_BASE) || !defined(PLAT_PCI_BATCH_NS_BUF_SIZE)
+#error "SMC_PCI_BATCH requires PLAT_PCI_BATCH_NS_BUF_BASE and PLAT_PCI_BATCH_NS_BUF_SIZE"
+#endif
+#endif
+
 static uint64_t validate_rw_addr_sz(uint32_t addr, uint64_t off, uint64_t sz)
 {
 	uint32_t nseg;
@@ -38,6 +47,118 @@ static uint64_t validate_rw_addr_sz(uint32_t addr, uint64_t off, uint64_t sz)
 	return SMC_PCI_CALL_SUCCESS;
 }
 
+#if SMC_PCI_BATCH
+/*
+ * Perform the accesses of a batch list once it is mapped. The segment is only
+ * validated for the first entry, the following entries must target the same
+ * segment. Processing stops at the first entry that fails; the number of
+ * entries processed is returned through 'done'.
+ */
+static int pci_batch_run(pci_batch_op_t *ops, uint32_t count, uint32_t *done)
+{
+	pci_batch_op_t op;
+	uint32_t seg = 0U;
+	uint32_t i;
+	int ret = SMC_PCI_CALL_SUCCESS;
+
+	for (i = 0U; i < count; i++) {
+		/* Work on a copy, the list may be modified concurrently */
+		op = ops[i];
+
+		if (i == 0U) {
+			seg = PCI_ADDR_SEG(op.addr);
+			ret = (int)validate_rw_addr_sz(op.addr, op.off, op.sz);
+		} else if (PCI_ADDR_SEG(op.addr) != seg) {
+			ret = SMC_PCI_CALL_INVAL_PARAM;
+		} else if (((op.sz != SMC_PCI_SZ_8BIT) &&
+			    (op.sz != SMC_PCI_SZ_16BIT) &&
+			    (op.sz != SMC_PCI_SZ_32BIT)) ||
+			   ((op.off + op.sz) > (PCI_OFFSET_MASK + 1U))) {
+			ret = SMC_PCI_CALL_INVAL_PARAM;
+		}
+
+		if (ret == SMC_PCI_CALL_SUCCESS) {
+			switch (op.op) {
+			case SMC_PCI_BATCH_OP_READ:
+				if (pci_read_config(op.addr, op.off, op.sz,
+						    &op.val) != 0U) {
+					ret = SMC_PCI_CALL_INVAL_PARAM;
+				}
+				break;
+			case SMC_PCI_BATCH_OP_WRITE:
+				ret = (int)pci_write_config(op.addr, op.off,
+							    op.sz, op.val);
+				break;
+			default:
+				ret = SMC_PCI_CALL_INVAL_PARAM;
+				break;
+			}
+		}
+
+		ops[i].val = op.val;
+		ops[i].status = ret;
+
+		if (ret != SMC_PCI_CALL_SUCCESS) {
+			break;
+		}
+	}
+
+	*done = i;
+
+	return ret;
+}
+
+/*
+ * Run the batch list at physical address 'pa', which must lie within the
+ * Non-secure window declared by the platform. The window is mapped as
+ * Non-secure memory, so the list cannot be used to access Secure memory.
+ */
+static int pci_batch_handler(uint64_t pa, uint32_t count, uint32_t *done)
+{
+	uint64_t size;
+
+	*done = 0U;
+
+	if ((count == 0U) || (count > SMC_PCI_BATCH_MAX_OPS) ||
+	    ((pa & (sizeof(pci_batch_op_t) - 1U)) != 0U)) {
+		return SMC_PCI_CALL_INVAL_PARAM;
+	}
+
+	size = (uint64_t)count * sizeof(pci_batch_op_t);
+
+	if ((pa < PLAT_PCI_BATCH_NS_BUF_BASE) ||
+	    (size > PLAT_PCI_BATCH_NS_BUF_SIZE) ||
+	    ((pa - PLAT_PCI_BATCH_NS_BUF_BASE) >
+	     (PLAT_PCI_BATCH_NS_BUF_SIZE - size))) {
+		return SMC_PCI_CALL_INVAL_PARAM;
+	}
+
+	return pci_batch_run((pci_batch_op_t *)(uintptr_t)pa, count, done);
+}
+
+/*
+ * Handler of SMC_PCI_RW_BATCH, called from the SiP service of the platform.
+ * x1/x2 hold the low/high words of the list address and x3 the number of
+ * entries.
+ */
+uintptr_t pci_batch_smc_handler(uint32_t smc_fid, u_register_t x1,
+				u_register_t x2, u_register_t x3,
+				u_register_t x4, void *cookie, void *handle,
+				u_register_t flags)
+{
+	uint32_t done;
+	int ret;
+
+	if (x4 != 0U) {
+		SMC_RET2(handle, SMC_PCI_CALL_INVAL_PARAM, 0U);
+	}
+
+	ret = pci_batch_handler(((uint64_t)(uint32_t)x2 << 32) | (uint32_t)x1,
+				(uint32_t)x3, &done);
+	SMC_RET2(handle, ret, done);
+}
+#endif /* SMC_PCI_BATCH */
+
 uint64_t pci_smc_handler(uint32_t smc_fid,
 			     u_register_t x1,
 			     u_register_t x2,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -52,6 +52,11 @@ typedef struct sdei_cpu_state {
 	unsigned short stack_top; /* Empty ascending */
 	bool pe_masked;
 	bool pending_enables;
+#if SDEI_CONTEXT_BUFFER
+	/* Context buffer registered by the client, split in two records */
+	uintptr_t ctx_buf;
+	size_t ctx_rec_size;
+#endif
 } sdei_cpu_state_t;
 
 /* SDEI states for all cores in the system */
@@ -305,6 +310,107 @@ static void sdei_set_elr_spsr(sdei_entry_t *se, sdei_dispatch_context_t *disp_ct
 	cm_set_elr_spsr_el3(NON_SECURE, (uintptr_t) se->ep, sdei_spsr);
 }
 
+#if SDEI_CONTEXT_BUFFER
+/*
+ * Register the buffer into which the context of the interrupted PE is copied
+ * on dispatch. The buffer must lie in the Non-secure memory that the platform
+ * shares with EL3 for this purpose. A base address of 0 unregisters the
+ * buffer.
+ */
+int64_t sdei_event_context_buffer(uint64_t base, uint64_t size)
+{
+	sdei_cpu_state_t *state = sdei_get_this_pe_state();
+	size_t rec_size;
+
+	/* The buffer can't change under the feet of a running handler */
+	if (get_outstanding_dispatch() != NULL)
+		return SDEI_EDENY;
+
+	if (base == 0U) {
+		state->ctx_buf = 0U;
+		state->ctx_rec_size = 0U;
+		return 0;
+	}
+
+	rec_size = (size_t) (size / 2U) & ~(sizeof(uint64_t) - 1U);
+	if (((base & (sizeof(uint64_t) - 1U)) != 0U) ||
+	    (rec_size < sizeof(sdei_ctx_record_t)) ||
+	    (base < PLAT_SDEI_CTX_BUF_BASE) ||
+	    (size > PLAT_SDEI_CTX_BUF_SIZE) ||
+	    ((base - PLAT_SDEI_CTX_BUF_BASE) > (PLAT_SDEI_CTX_BUF_SIZE - size)))
+		return SDEI_EINVAL;
+
+	state->ctx_buf = (uintptr_t) base;
+	state->ctx_rec_size = rec_size;
+
+	return 0;
+}
+
+/*
+ * Unregister the context buffer of the calling PE or, on a shared reset, of all
+ * the PEs, so that no context is copied into memory the client may have
+ * reclaimed. Other PEs only ever see their registration cleared.
+ */
+void sdei_context_buffer_reset(bool all_pes)
+{
+	sdei_cpu_state_t *state;
+	unsigned int i;
+
+	if (!all_pes) {
+		state = sdei_get_this_pe_state();
+		state->ctx_buf = 0U;
+		state->ctx_rec_size = 0U;
+		return;
+	}
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		state = &cpu_state[i];
+		state->ctx_buf = 0U;
+		state->ctx_rec_size = 0U;
+	}
+}
+
+/*
+ * Copy the interrupted context saved for the dispatch, and any data provided by
+ * the platform for the event, to the record of the event class in the context
+ * buffer of this PE.
+ */
+static void copy_event_ctx(const sdei_dispatch_context_t *disp_ctx)
+{
+	const volatile sdei_cpu_state_t *state = sdei_get_this_pe_state();
+	sdei_ctx_record_t *rec;
+	uintptr_t ctx_buf;
+	size_t rec_size;
+	unsigned int idx;
+
+	CASSERT(SDEI_CTX_NUM_GPREGS == SDEI_SAVED_GPREGS,
+		assert_sdei_ctx_gpregs_mismatch);
+
+	/*
+	 * Take a snapshot of the registration, which a shared reset on another
+	 * PE may clear at any time.
+	 */
+	ctx_buf = state->ctx_buf;
+	rec_size = state->ctx_rec_size;
+	if ((ctx_buf == 0U) || (rec_size == 0U))
+		return;
+
+	idx = is_event_critical(disp_ctx->map) ? SDEI_CTX_REC_CRITICAL :
+		SDEI_CTX_REC_NORMAL;
+	rec = (sdei_ctx_record_t *) (ctx_buf + (idx * rec_size));
+
+	memcpy(rec->x, disp_ctx->x, sizeof(rec->x));
+	rec->elr = disp_ctx->elr_el3;
+	rec->spsr = disp_ctx->spsr_el3;
+	rec->data_size = plat_sdei_get_event_data(disp_ctx->map->ev_num,
+			rec->data, rec_size - sizeof(*rec));
+	assert(rec->data_size <= (rec_size - sizeof(*rec)));
+
+	/* Written last, for the client to identify the context it reads */
+	rec->ev_num = disp_ctx->map->ev_num;
+}
+#endif /* SDEI_CONTEXT_BUFFER */
+
 /*
  * Populate the Non-secure context so that the next ERET will dispatch to the
  * SDEI client.
@@ -317,6 +423,11 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 	/* Push the event and context */
 	disp_ctx = save_event_ctx(map, ctx);
 
+#if SDEI_CONTEXT_BUFFER
+	/* Hand the interrupted context over to the client in bulk */
+	copy_event_ctx(disp_ctx);
+#endif
+
 	/*
 	 * Setup handler arguments:
 	 *
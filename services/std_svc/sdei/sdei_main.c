@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -946,6 +946,39 @@ static uint64_t sdei_features(unsigned int feature)
 	return (uint64_t) SDEI_EINVAL;
 }
 
+#if SDEI_CONTEXT_BUFFER
+/*
+ * Handler of SDEI_EVENT_CONTEXT_BUFFER, called from the SiP service of the
+ * platform. The call is subject to the same caller checks as the SDEI calls.
+ */
+uint64_t sdei_ctx_buf_smc_handler(uint32_t smc_fid,
+				  uint64_t x1,
+				  uint64_t x2,
+				  uint64_t x3,
+				  uint64_t x4,
+				  void *cookie,
+				  void *handle,
+				  uint64_t flags)
+{
+	unsigned int ss = (unsigned int) get_interrupt_src_ss(flags);
+	cpu_context_t *ctx = handle;
+	int64_t ret;
+
+	if (ss != NON_SECURE)
+		SMC_RET1(ctx, SMC_UNK);
+
+	/* Verify the caller EL */
+	if (GET_EL(read_spsr_el3()) != sdei_client_el())
+		SMC_RET1(ctx, SMC_UNK);
+
+	SDEI_LOG("> CTX_BUF(b:%" PRIx64 " s:%" PRIx64 "):%lx\n", x1, x2,
+		 read_mpidr_el1());
+	ret = sdei_event_context_buffer(x1, x2);
+	SDEI_LOG("< CTX_BUF:%" PRId64 "\n", ret);
+	SMC_RET1(ctx, ret);
+}
+#endif /* SDEI_CONTEXT_BUFFER */
+
 /* SDEI top level handler for servicing SMCs */
 uint64_t sdei_smc_handler(uint32_t smc_fid,
 			  uint64_t x1,
@@ -1071,12 +1104,18 @@ uint64_t sdei_smc_handler(uint32_t smc_fid,
 	case SDEI_SHARED_RESET:
 		SDEI_LOG("> S_RESET():%lx\n", read_mpidr_el1());
 		ret = sdei_shared_reset();
+#if SDEI_CONTEXT_BUFFER
+		sdei_context_buffer_reset(true);
+#endif
 		SDEI_LOG("< S_RESET:%" PRId64 "\n", ret);
 		SMC_RET1(ctx, ret);
 
 	case SDEI_PRIVATE_RESET:
 		SDEI_LOG("> P_RESET():%lx\n", read_mpidr_el1());
 		ret = sdei_private_reset();
+#if SDEI_CONTEXT_BUFFER
+		sdei_context_buffer_reset(false);
+#endif
 		SDEI_LOG("< P_RESET:%" PRId64 "\n", ret);
 		SMC_RET1(ctx, ret);
 
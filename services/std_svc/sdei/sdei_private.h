@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -34,6 +34,12 @@
 # error Platform must define SDEI normal priority value
 #endif
 
+#if SDEI_CONTEXT_BUFFER
+# if !defined(PLAT_SDEI_CTX_BUF_BASE) || !defined(PLAT_SDEI_CTX_BUF_SIZE)
+#  error Platform must define the SDEI context buffer region
+# endif
+#endif
+
 /* Output SDEI logs as verbose */
 #define SDEI_LOG(...)	VERBOSE("SDEI: " __VA_ARGS__)
 
@@ -235,6 +241,10 @@ sdei_ev_map_t *find_event_map(int ev_num);
 sdei_entry_t *get_event_entry(sdei_ev_map_t *map);
 
 int64_t sdei_event_context(void *handle, unsigned int param);
+#if SDEI_CONTEXT_BUFFER
+int64_t sdei_event_context_buffer(uint64_t base, uint64_t size);
+void sdei_context_buffer_reset(bool all_pes);
+#endif
 int sdei_event_complete(bool resume, uint64_t pc);
 
 void sdei_pe_unmask(void);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,6 +22,7 @@
 #define OPT_TOC_ENTRY 0
 #define OPT_PLAT_TOC_FLAGS 1
 #define OPT_ALIGN 2
+#define OPT_IN_PLACE 3
 
 static int info_cmd(int argc, char *argv[]);
 static void info_usage(int);
@@ -33,6 +34,8 @@ static int unpack_cmd(int argc, char *argv[]);
 static void unpack_usage(int);
 static int remove_cmd(int argc, char *argv[]);
 static void remove_usage(int);
+static int delta_cmd(int argc, char *argv[]);
+static void delta_usage(int);
 static int version_cmd(int argc, char *argv[]);
 static void version_usage(int);
 static int help_cmd(int argc, char *argv[]);
@@ -45,6 +48,7 @@ static cmd_t cmds[] = {
 	{ .name = "update",  .handler = update_cmd,  .usage = update_usage  },
 	{ .name = "unpack",  .handler = unpack_cmd,  .usage = unpack_usage  },
 	{ .name = "remove",  .handler = remove_cmd,  .usage = remove_usage  },
+	{ .name = "delta",   .handler = delta_cmd,   .usage = delta_usage   },
 	{ .name = "version", .handler = version_cmd, .usage = version_usage },
 	{ .name = "help",    .handler = help_cmd,    .usage = NULL          },
 };
@@ -290,6 +294,28 @@ static void uuid_from_str(uuid_t *u, const char *s)
 		log_errx("Invalid UUID: %s", s);
 }
 
+static char *read_file(const char *filename, size_t *size)
+{
+	struct BLD_PLAT_STAT st;
+	FILE *fp;
+	char *buf;
+
+	fp = fopen(filename, "rb");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	if (fstat(fileno(fp), &st) == -1)
+		log_err("fstat %s", filename);
+
+	buf = xmalloc(st.st_size, "failed to load file into memory");
+	if (fread(buf, 1, st.st_size, fp) != st.st_size)
+		log_errx("Failed to read %s", filename);
+	fclose(fp);
+
+	*size = st.st_size;
+	return buf;
+}
+
 static int parse_fip(const char *filename, fip_toc_header_t *toc_header_out)
 {
 	struct BLD_PLAT_STAT st;
@@ -627,6 +653,136 @@ static void update_fip(void)
 	}
 }
 
+static void xfwrite_at(void *buf, size_t size, uint64_t offset, FILE *fp,
+    const char *filename)
+{
+	if (fseek(fp, offset, SEEK_SET))
+		log_errx("Failed to set file position");
+	xfwrite(buf, size, fp, filename);
+}
+
+/*
+ * Replace the images to be packed in an existing FIP without moving any
+ * other image, so that only the replaced images and their ToC entries are
+ * rewritten. Each new image must fit in the slot of the image it replaces,
+ * which ends where the next image starts, or at the end of the FIP.
+ */
+static void update_fip_in_place(const char *filename,
+    unsigned long long toc_flags, int pflag)
+{
+	FILE *fp;
+	char *buf;
+	size_t size;
+	fip_toc_header_t *toc_header;
+	fip_toc_entry_t *first, *end, *toc_entry, *e;
+	image_desc_t *desc;
+	uint64_t flags;
+
+	buf = read_file(filename, &size);
+	if (size < sizeof(fip_toc_header_t))
+		log_errx("FIP %s is truncated", filename);
+
+	toc_header = (fip_toc_header_t *)buf;
+	if (toc_header->name != TOC_HEADER_NAME)
+		log_errx("%s is not a FIP file", filename);
+
+	first = (fip_toc_entry_t *)(toc_header + 1);
+	for (end = first; ; end++) {
+		if ((char *)(end + 1) > buf + size)
+			log_errx("FIP %s does not have a ToC terminator entry",
+			    filename);
+		if (memcmp(&end->uuid, &uuid_null, sizeof(uuid_t)) == 0)
+			break;
+		if (end->size > (uint64_t)-1 - end->offset_address ||
+		    end->size + end->offset_address > size)
+			log_errx("FIP %s is corrupted", filename);
+	}
+
+	fp = fopen(filename, "r+b");
+	if (fp == NULL)
+		log_err("fopen %s", filename);
+
+	flags = toc_header->flags;
+	if (pflag)
+		flags &= ~(0xffffULL << 32);
+	flags |= toc_flags;
+	if (flags != toc_header->flags) {
+		toc_header->flags = flags;
+		xfwrite_at(toc_header, sizeof(*toc_header), 0, fp, filename);
+	}
+
+	for (desc = image_desc_head; desc != NULL; desc = desc->next) {
+		image_t *image;
+		uint64_t slot_end, slot_size, pad_size;
+
+		if (desc->action != DO_PACK)
+			continue;
+
+		for (toc_entry = first; toc_entry < end; toc_entry++)
+			if (memcmp(&toc_entry->uuid, &desc->uuid,
+			    sizeof(uuid_t)) == 0)
+				break;
+		if (toc_entry == end)
+			log_errx("%s is not in %s and can't be added in place",
+			    desc->cmdline_name, filename);
+
+		/* The slot ends where the next image, or the FIP, ends. */
+		slot_end = size;
+		for (e = first; e <= end; e++) {
+			if (e != toc_entry && e < end &&
+			    e->offset_address == toc_entry->offset_address &&
+			    e->size != 0)
+				log_errx("%s shares its data in %s",
+				    desc->cmdline_name, filename);
+			if (e->offset_address > toc_entry->offset_address &&
+			    e->offset_address < slot_end)
+				slot_end = e->offset_address;
+		}
+		slot_size = slot_end - toc_entry->offset_address;
+
+		image = read_image_from_file(&desc->uuid, desc->action_arg);
+		if (image->toc_e.size > slot_size)
+			log_errx("%s (%llu bytes) does not fit in its %llu bytes "
+			    "slot in %s", desc->action_arg,
+			    (unsigned long long)image->toc_e.size,
+			    (unsigned long long)slot_size, filename);
+
+		if (image->toc_e.size == toc_entry->size &&
+		    memcmp(image->buffer, buf + toc_entry->offset_address,
+		    image->toc_e.size) == 0) {
+			if (verbose)
+				log_dbgx("%s is unchanged", desc->cmdline_name);
+			free(image->buffer);
+			free(image);
+			continue;
+		}
+
+		if (verbose)
+			log_dbgx("Replacing %s in place with %s",
+			    desc->cmdline_name, desc->action_arg);
+
+		xfwrite_at(image->buffer, image->toc_e.size,
+		    toc_entry->offset_address, fp, filename);
+
+		/* Clear what is left of the previous image. */
+		if (toc_entry->size > image->toc_e.size) {
+			pad_size = toc_entry->size - image->toc_e.size;
+			while (pad_size--)
+				fputc(0x0, fp);
+		}
+
+		toc_entry->size = image->toc_e.size;
+		xfwrite_at(toc_entry, sizeof(*toc_entry),
+		    (char *)toc_entry - buf, fp, filename);
+
+		free(image->buffer);
+		free(image);
+	}
+
+	fclose(fp);
+	free(buf);
+}
+
 static void parse_plat_toc_flags(const char *arg, unsigned long long *toc_flags)
 {
 	unsigned long long flags;
@@ -783,6 +939,7 @@ static int update_cmd(int argc, char *argv[])
 	unsigned long long toc_flags = 0;
 	unsigned long align = 1;
 	int pflag = 0;
+	int inplace = 0;
 
 	if (argc < 2)
 		update_usage(EXIT_FAILURE);
@@ -790,6 +947,7 @@ static int update_cmd(int argc, char *argv[])
 	opts = fill_common_opts(opts, &nr_opts, required_argument);
 	opts = add_opt(opts, &nr_opts, "align", required_argument, OPT_ALIGN);
 	opts = add_opt(opts, &nr_opts, "blob", required_argument, 'b');
+	opts = add_opt(opts, &nr_opts, "in-place", no_argument, OPT_IN_PLACE);
 	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
 	opts = add_opt(opts, &nr_opts, "plat-toc-flags", required_argument,
 	    OPT_PLAT_TOC_FLAGS);
@@ -839,6 +997,9 @@ static int update_cmd(int argc, char *argv[])
 		case OPT_ALIGN:
 			align = get_image_align(optarg);
 			break;
+		case OPT_IN_PLACE:
+			inplace = 1;
+			break;
 		case 'o':
 			snprintf(outfile, sizeof(outfile), "%s", optarg);
 			break;
@@ -853,6 +1014,13 @@ static int update_cmd(int argc, char *argv[])
 	if (argc == 0)
 		update_usage(EXIT_SUCCESS);
 
+	if (inplace) {
+		if (outfile[0] != '\0' || align != 1)
+			log_errx("--in-place can't be used with --out or --align");
+		update_fip_in_place(argv[0], toc_flags, pflag);
+		return 0;
+	}
+
 	if (outfile[0] == '\0')
 		snprintf(outfile, sizeof(outfile), "%s", argv[0]);
 
@@ -878,6 +1046,7 @@ static void update_usage(int exit_status)
 	printf("Options:\n");
 	printf("  --align <value>\t\tEach image is aligned to <value> (default: 1).\n");
 	printf("  --blob uuid=...,file=...\tAdd or update an image with the given UUID pointed to by file.\n");
+	printf("  --in-place\t\t\tOverwrite the images without moving the others, if they fit in their slot.\n");
 	printf("  --out FIP_FILENAME\t\tSet an alternative output FIP file.\n");
 	printf("  --plat-toc-flags <value>\t16-bit platform specific flag field occupying bits 32-47 in 64-bit ToC header.\n");
 	printf("\n");
@@ -1165,6 +1334,122 @@ static void remove_usage(int exit_status)
 	exit(exit_status);
 }
 
+static void delta_add_chunk(FILE *fp, const char *filename, const char *buf,
+    uint64_t offset, uint64_t size)
+{
+	fip_delta_chunk_t chunk = { .offset = offset, .size = size };
+
+	xfwrite(&chunk, sizeof(chunk), fp, filename);
+	xfwrite((void *)(buf + offset), size, fp, filename);
+}
+
+static int delta_cmd(int argc, char *argv[])
+{
+	struct option *opts = NULL;
+	size_t nr_opts = 0;
+	char outfile[PATH_MAX] = { 0 };
+	fip_delta_header_t header = { 0 };
+	uint64_t data_size = 0, i, start, end;
+	char *old, *new;
+	size_t old_size, new_size;
+	FILE *fp;
+
+	if (argc < 2)
+		delta_usage(EXIT_FAILURE);
+
+	opts = add_opt(opts, &nr_opts, "out", required_argument, 'o');
+	opts = add_opt(opts, &nr_opts, NULL, 0, 0);
+
+	while (1) {
+		int c, opt_index = 0;
+
+		c = getopt_long(argc, argv, "o:", opts, &opt_index);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'o':
+			snprintf(outfile, sizeof(outfile), "%s", optarg);
+			break;
+		default:
+			delta_usage(EXIT_FAILURE);
+		}
+	}
+	argc -= optind;
+	argv += optind;
+	free(opts);
+
+	if (argc != 2 || outfile[0] == '\0')
+		delta_usage(EXIT_FAILURE);
+
+	old = read_file(argv[0], &old_size);
+	new = read_file(argv[1], &new_size);
+	if (new_size < sizeof(fip_toc_header_t) ||
+	    ((fip_toc_header_t *)new)->name != TOC_HEADER_NAME)
+		log_errx("%s is not a FIP file", argv[1]);
+
+	fp = fopen(outfile, "wb");
+	if (fp == NULL)
+		log_err("fopen %s", outfile);
+
+	/* The header is rewritten once the number of chunks is known. */
+	header.magic = FIP_DELTA_MAGIC;
+	header.version = FIP_DELTA_VERSION;
+	header.old_size = old_size;
+	header.new_size = new_size;
+	xfwrite(&header, sizeof(header), fp, outfile);
+
+#define DIFFERS(_i)	((_i) >= old_size || old[(_i)] != new[(_i)])
+	for (i = 0; i < new_size; ) {
+		if (!DIFFERS(i)) {
+			i++;
+			continue;
+		}
+
+		/*
+		 * Extend the chunk over the following changes, unless the
+		 * unchanged bytes in between are larger than a chunk header.
+		 */
+		start = i;
+		end = ++i;
+		while (i < new_size) {
+			if (DIFFERS(i))
+				end = ++i;
+			else if (i - end < sizeof(fip_delta_chunk_t))
+				i++;
+			else
+				break;
+		}
+
+		delta_add_chunk(fp, outfile, new, start, end - start);
+		header.nr_chunks++;
+		data_size += end - start;
+		i = end;
+	}
+#undef DIFFERS
+
+	xfwrite_at(&header, sizeof(header), 0, fp, outfile);
+	fclose(fp);
+
+	if (verbose)
+		log_dbgx("%llu chunks, %llu bytes of data",
+		    (unsigned long long)header.nr_chunks,
+		    (unsigned long long)data_size);
+
+	free(old);
+	free(new);
+	return 0;
+}
+
+static void delta_usage(int exit_status)
+{
+	printf("fiptool delta --out DELTA_FILENAME OLD_FIP_FILENAME NEW_FIP_FILENAME\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  --out DELTA_FILENAME\tSet the file the changes are written to.\n");
+	exit(exit_status);
+}
+
 static int version_cmd(int argc, char *argv[])
 {
 #ifdef VERSION
@@ -1212,6 +1497,7 @@ static void usage(void)
 	printf("  update\tUpdate an existing FIP with the given images.\n");
 	printf("  unpack\tUnpack images from FIP.\n");
 	printf("  remove\tRemove images from FIP.\n");
+	printf("  delta\t\tGenerate the changes between two FIPs.\n");
 	printf("  version\tShow fiptool version.\n");
 	printf("  help\t\tShow help for given command.\n");
 	exit(EXIT_SUCCESS);
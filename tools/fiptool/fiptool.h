@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2022, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -45,6 +45,28 @@ typedef struct image {
 	void                *buffer;
 } image_t;
 
+/*
+ * A FIP delta, generated by the delta subcommand, is made of a header followed
+ * by nr_chunks chunks. Each chunk is a header followed by the size bytes of
+ * data to be written at offset in the old FIP to turn it into the new FIP,
+ * which is new_size bytes long. All fields are little-endian.
+ */
+#define FIP_DELTA_MAGIC		0x544c4446	/* "FDLT" */
+#define FIP_DELTA_VERSION	1
+
+typedef struct fip_delta_header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t old_size;
+	uint64_t new_size;
+	uint64_t nr_chunks;
+} fip_delta_header_t;
+
+typedef struct fip_delta_chunk {
+	uint64_t offset;
+	uint64_t size;
+} fip_delta_chunk_t;
+
 typedef struct cmd {
 	char              *name;
 	int              (*handler)(int, char **);
@@ -1,15 +1,18 @@
 /*
- * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <fcntl.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "sptool.h"
@@ -20,7 +23,7 @@
  * Entry describing Secure Partition package.
  */
 struct sp_pkg_info {
-	/* Location of the files in the host's RAM. */
+	/* Location of the files mapped in the host's RAM. */
 	void *img_data, *pm_data;
 
 	/* Size of the files. */
@@ -99,11 +102,11 @@ static void cleanup(struct sp_pkg_info *sp)
 
 	if (sp != NULL) {
 		if (sp->img_data != NULL) {
-			free(sp->img_data);
+			munmap(sp->img_data, sp->img_size);
 		}
 
 		if (sp->pm_data != NULL) {
-			free(sp->pm_data);
+			munmap(sp->pm_data, sp->pm_size);
 		}
 
 		free(sp);
@@ -149,39 +152,58 @@ static void append_user_input(struct arg_list **head, char *args)
 }
 
 /*
- * Allocate a buffer big enough to store the content of the specified file and
- * load the file into it. Fill 'size' with the file size. Exit the program on
- * error.
+ * Map the content of the specified file in memory, read-only. Fill 'size' with
+ * the file size. Return -1 if the file can't be opened, or is empty, and exit
+ * the program on any other error.
  */
-static void load_file(const char *path, void **ptr, uint32_t *size)
+static int map_file(const char *path, void **ptr, uint32_t *size)
 {
-	FILE *f = fopen(path, "rb");
-	if (f == NULL) {
-		fprintf(stderr, "error: %s couldn't be opened.\n", path);
-		exit(1);
+	struct stat st;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return -1;
 	}
 
-	xfseek(f, 0, SEEK_END);
-	*size = ftell(f);
-	if (*size == 0) {
-		fprintf(stderr, "error: Size of %s is 0\n", path);
+	if (fstat(fd, &st) != 0) {
+		fprintf(stderr, "error: Couldn't stat %s\n", path);
 		exit(1);
 	}
 
-	rewind(f);
+	if (st.st_size == 0) {
+		close(fd);
+		return -1;
+	}
 
-	*ptr = malloc(*size);
-	if (*ptr == NULL) {
-		fprintf(stderr, "error: Not enough memory to load %s\n", path);
+	if ((uint64_t)st.st_size > UINT32_MAX) {
+		fprintf(stderr, "error: %s is too big\n", path);
 		exit(1);
 	}
 
-	if (fread(*ptr, *size, 1, f) != 1) {
-		fprintf(stderr, "error: Couldn't read %s\n", path);
+	*size = (uint32_t)st.st_size;
+	*ptr = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (*ptr == MAP_FAILED) {
+		fprintf(stderr, "error: Couldn't map %s\n", path);
 		exit(1);
 	}
 
-	fclose(f);
+	close(fd);
+
+	return 0;
+}
+
+/*
+ * Map the content of the specified input file in memory. Fill 'size' with
+ * the file size. Exit the program on error.
+ */
+static void load_file(const char *path, void **ptr, uint32_t *size)
+{
+	if (map_file(path, ptr, size) != 0) {
+		fprintf(stderr, "error: %s couldn't be opened or is empty.\n",
+			path);
+		exit(1);
+	}
 }
 
 /*
@@ -211,13 +233,95 @@ static void load_sp_pm(char *path, struct sp_pkg_info **sp_out)
 	*sp_out = sp_pkg;
 }
 
+/*
+ * Compute the location of the partition manifest and image in the package.
+ */
+static void sp_pkg_layout(struct sp_pkg_info *sp, bool header)
+{
+	sp->pm_offset = 0;
+
+	/* Reserve Header size */
+	if (header) {
+		sp->pm_offset = sizeof(struct sp_pkg_header);
+	}
+
+	/* Partition image is aligned to Page size */
+	sp->img_offset = align_to((sp->pm_offset + sp->pm_size), PAGE_SIZE);
+}
+
+static void sp_pkg_header_fill(struct sp_pkg_header *sp_header_info,
+			       const struct sp_pkg_info *sp)
+{
+	memset(sp_header_info, 0, sizeof(*sp_header_info));
+	sp_header_info->magic = SECURE_PARTITION_MAGIC;
+	sp_header_info->version = 0x1;
+	sp_header_info->img_offset = sp->img_offset;
+	sp_header_info->img_size = sp->img_size;
+	sp_header_info->pm_offset = sp->pm_offset;
+	sp_header_info->pm_size = sp->pm_size;
+}
+
+/* Check that 'size' bytes at 'buf' are all zero. */
+static bool is_zero(const uint8_t *buf, size_t size)
+{
+	while (size-- > 0U) {
+		if (*buf++ != 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Compare the content of an existing package file with the package that would
+ * be generated. Leaving an unchanged package untouched preserves its
+ * timestamp, so that the images depending on it are not rebuilt.
+ */
+static bool output_is_current(const char *path, struct sp_pkg_info *sp,
+			      bool header)
+{
+	struct sp_pkg_header sp_header_info;
+	uint32_t pm_end = sp->pm_offset + sp->pm_size;
+	uint32_t size;
+	uint8_t *data;
+	bool current;
+
+	if (map_file(path, (void **)&data, &size) != 0) {
+		return false;
+	}
+
+	current = (size == (sp->img_offset + sp->img_size));
+
+	if (current && header) {
+		sp_pkg_header_fill(&sp_header_info, sp);
+		current = memcmp(data, &sp_header_info,
+				 sizeof(sp_header_info)) == 0;
+	}
+
+	current = current &&
+		  (memcmp(data + sp->pm_offset, sp->pm_data, sp->pm_size) == 0) &&
+		  is_zero(data + pm_end, sp->img_offset - pm_end) &&
+		  (memcmp(data + sp->img_offset, sp->img_data,
+			  sp->img_size) == 0);
+
+	munmap(data, size);
+
+	return current;
+}
+
 /*
  * Write SP package data structure into output file.
  */
 static void output_write(const char *path, struct sp_pkg_info *sp, bool header)
 {
 	struct sp_pkg_header sp_header_info;
-	unsigned int file_ptr = 0;
+
+	if (output_is_current(path, sp, header)) {
+		printf("\nsptool: Secure Partition blob %s is up to date\n",
+		       path);
+		return;
+	}
 
 	FILE *f = fopen(path, "wb");
 	if (f == NULL) {
@@ -225,36 +329,23 @@ static void output_write(const char *path, struct sp_pkg_info *sp, bool header)
 		exit(1);
 	}
 
-	/* Reserve Header size */
-	if (header) {
-		file_ptr = sizeof(struct sp_pkg_header);
-	}
-
 	/* Save partition manifest */
-	xfseek(f, file_ptr, SEEK_SET);
+	xfseek(f, sp->pm_offset, SEEK_SET);
 	printf("Writing SP Manifest at offset 0x%x (%u bytes)\n",
-	       file_ptr, sp->pm_size);
+	       sp->pm_offset, sp->pm_size);
 
-	sp->pm_offset = file_ptr;
 	xfwrite(sp->pm_data, sp->pm_size, f);
 
 	/* Save partition image aligned to Page size */
-	file_ptr = align_to((sp->pm_offset + sp->pm_size), PAGE_SIZE);
-	xfseek(f, file_ptr, SEEK_SET);
+	xfseek(f, sp->img_offset, SEEK_SET);
 	printf("Writing SP Image at offset 0x%x (%u bytes)\n",
-	       file_ptr, sp->img_size);
+	       sp->img_offset, sp->img_size);
 
-	sp->img_offset = file_ptr;
 	xfwrite(sp->img_data, sp->img_size, f);
 
 	/* Finally, write header, if needed */
 	if (header) {
-		sp_header_info.magic = SECURE_PARTITION_MAGIC;
-		sp_header_info.version = 0x1;
-		sp_header_info.img_offset = sp->img_offset;
-		sp_header_info.img_size = sp->img_size;
-		sp_header_info.pm_offset = sp->pm_offset;
-		sp_header_info.pm_size = sp->pm_size;
+		sp_pkg_header_fill(&sp_header_info, sp);
 
 		xfseek(f, 0, SEEK_SET);
 
@@ -282,7 +373,8 @@ static void usage(void)
 
 	printf("This tool takes as input set of image binary files and the\n"
 	       "partition manifest blobs as input and generates set of\n"
-	       "output package files\n"
+	       "output package files. Packages whose content would not change\n"
+	       "are left untouched.\n"
 	       "Usage example: sptool -i sp1.bin:sp1.dtb -o sp1.pkg\n"
 	       "                      -i sp2.bin:sp2.dtb -o sp2.pkg ...\n\n");
 	printf("Commands supported:\n");
@@ -344,7 +436,9 @@ int main(int argc, char *argv[])
 	out_list = out_head;
 	while (in_list != NULL) {
 		load_sp_pm(in_list->usr_input, &sp_pkg);
+		sp_pkg_layout(sp_pkg, need_header);
 		output_write(out_list->usr_input, sp_pkg, need_header);
+		cleanup(sp_pkg);
 		in_list = in_list->next;
 		out_list = out_list->next;
 	}
@@ -352,7 +446,6 @@ int main(int argc, char *argv[])
 	argc -= optind;
 	argv += optind;
 
-	cleanup(sp_pkg);
 	freelist(in_head);
 	freelist(out_head);
 
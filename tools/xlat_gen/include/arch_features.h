@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Host implementation of the feature checks used by the xlat tables library */
+
+#ifndef ARCH_FEATURES_H
+#define ARCH_FEATURES_H
+
+#include <stdbool.h>
+
+/* Set by xlat_gen when the target implements BTI */
+extern bool xlat_gen_bti;
+
+static inline bool is_armv8_5_bti_present(void)
+{
+	return xlat_gen_bti;
+}
+
+/*
+ * The tables do not depend on the following features, assume the smallest
+ * set of them.
+ */
+static inline bool is_armv8_4_ttst_present(void)
+{
+	return false;
+}
+
+static inline bool is_armv8_2_ttcnp_present(void)
+{
+	return false;
+}
+
+#endif /* ARCH_FEATURES_H */
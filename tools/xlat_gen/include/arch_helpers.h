@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host implementation of the architectural helpers used by the translation
+ * table library. The tables are built as if the MMU and the data cache were
+ * disabled, at the exception level of the translation regime being generated.
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <arch.h>
+
+typedef uint64_t u_register_t;
+
+/* Exception level and ID_AA64MMFR0_EL1 value of the target, set by xlat_gen */
+extern unsigned int xlat_gen_current_el;
+extern u_register_t xlat_gen_id_aa64mmfr0_el1;
+
+static inline u_register_t read_CurrentEl(void)
+{
+	return (u_register_t)xlat_gen_current_el << MODE_EL_SHIFT;
+}
+
+static inline unsigned int get_current_el_maybe_constant(void)
+{
+	return xlat_gen_current_el;
+}
+
+static inline u_register_t read_id_aa64mmfr0_el1(void)
+{
+	return xlat_gen_id_aa64mmfr0_el1;
+}
+
+static inline u_register_t read_sctlr_el1(void)
+{
+	return 0U;
+}
+
+static inline u_register_t read_sctlr_el2(void)
+{
+	return 0U;
+}
+
+static inline u_register_t read_sctlr_el3(void)
+{
+	return 0U;
+}
+
+bool is_dcache_enabled(void);
+
+static inline void clean_dcache_range(uintptr_t addr, size_t size)
+{
+}
+
+static inline void dccvac(uint64_t addr)
+{
+}
+
+static inline void dsbish(void)
+{
+}
+
+static inline void dsbishst(void)
+{
+}
+
+static inline void isb(void)
+{
+}
+
+static inline void tlbivaae1is(uint64_t va)
+{
+}
+
+static inline void tlbivae2is(uint64_t va)
+{
+}
+
+static inline void tlbivae3is(uint64_t va)
+{
+}
+
+#endif /* ARCH_HELPERS_H */
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Use the definitions of the firmware C library with the host one */
+#include "../../../include/lib/libc/cdefs.h"
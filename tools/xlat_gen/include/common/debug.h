@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* Host implementation of the logging helpers used by the xlat tables library */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <stdio.h>
+
+#include <cdefs.h>
+
+#define LOG_LEVEL_NONE			0
+#define LOG_LEVEL_ERROR			10
+#define LOG_LEVEL_NOTICE		20
+#define LOG_LEVEL_WARNING		30
+#define LOG_LEVEL_INFO			40
+#define LOG_LEVEL_VERBOSE		50
+
+/* The state of the tables is printed on request only */
+int xlat_gen_printf(const char *fmt, ...) __printflike(1, 2);
+void __dead2 xlat_gen_panic(void);
+
+#define printf			xlat_gen_printf
+
+#define ERROR(...)		fprintf(stderr, "ERROR:   " __VA_ARGS__)
+#define WARN(...)		fprintf(stderr, "WARNING: " __VA_ARGS__)
+#define NOTICE(...)		xlat_gen_printf(__VA_ARGS__)
+#define INFO(...)		xlat_gen_printf(__VA_ARGS__)
+#define VERBOSE(...)		xlat_gen_printf(__VA_ARGS__)
+
+#define panic()			xlat_gen_panic()
+
+#endif /* DEBUG_H */
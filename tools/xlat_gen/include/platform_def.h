@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * xlat_gen is not built for a given platform. The translation contexts are
+ * created at run time, sized with the limits below.
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+#define XLAT_GEN_MAX_TABLES	512
+#define XLAT_GEN_MAX_REGIONS	256
+
+#endif /* PLATFORM_DEF_H */
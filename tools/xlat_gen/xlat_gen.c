@@ -0,0 +1,860 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * xlat_gen builds the translation tables of a static memory map on the host,
+ * with the translation table library of the firmware, and emits them as a C
+ * source file. The file defines the translation context of the BL image,
+ * which then doesn't have to build its tables at boot.
+ *
+ * The memory map is read from a file that has been preprocessed with the
+ * platform headers. It holds a list of statements:
+ *
+ *   xlat_context(virt_addr_space_size, phy_addr_space_size, regime)
+ *   MAP_REGION_FLAT(base, size, attr)
+ *   MAP_REGION(base_pa, base_va, size, attr)
+ *   MAP_REGION2(base_pa, base_va, size, attr, granularity)
+ *
+ * The arguments are C integer expressions, that can use the MT_* attributes,
+ * the *_REGIME identifiers and the symbols of the BL image given with -s.
+ */
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+
+#define XG_MAX_BASE_ENTRIES	512U
+
+#define ID_AA64MMFR0_EL1_PARANGE_52	ULL(0x6)
+
+#define SYM_NAME_LEN		128
+
+unsigned int xlat_gen_current_el = 3U;
+/* 4KB granule and 52-bit physical addresses (PARange 0b0110) supported */
+u_register_t xlat_gen_id_aa64mmfr0_el1 = ID_AA64MMFR0_EL1_PARANGE_52;
+bool xlat_gen_bti;
+
+static bool print_tables;
+
+typedef struct {
+	unsigned long long value;
+	char name[SYM_NAME_LEN];
+} symbol_t;
+
+static symbol_t *symbols;
+static size_t symbols_num;
+
+#define BUILTIN(_name)	{ (unsigned long long)(_name), #_name }
+
+static const struct {
+	unsigned long long value;
+	const char *name;
+} builtins[] = {
+	BUILTIN(MT_DEVICE),
+	BUILTIN(MT_NON_CACHEABLE),
+	BUILTIN(MT_MEMORY),
+	BUILTIN(MT_RO),
+	BUILTIN(MT_RW),
+	BUILTIN(MT_SECURE),
+	BUILTIN(MT_NS),
+	BUILTIN(MT_ROOT),
+	BUILTIN(MT_REALM),
+	BUILTIN(MT_EXECUTE),
+	BUILTIN(MT_EXECUTE_NEVER),
+	BUILTIN(MT_USER),
+	BUILTIN(MT_PRIVILEGED),
+	BUILTIN(MT_SHAREABILITY_ISH),
+	BUILTIN(MT_SHAREABILITY_OSH),
+	BUILTIN(MT_SHAREABILITY_NSH),
+	BUILTIN(MT_CODE),
+	BUILTIN(MT_RO_DATA),
+	BUILTIN(MT_RW_DATA),
+	BUILTIN(EL1_EL0_REGIME),
+	BUILTIN(EL2_REGIME),
+	BUILTIN(EL3_REGIME),
+	BUILTIN(PAGE_SIZE),
+	BUILTIN(REGION_DEFAULT_GRANULARITY),
+};
+
+/* Translation context built on the host */
+static uint64_t tables[XLAT_GEN_MAX_TABLES][XLAT_TABLE_ENTRIES]
+	__aligned(XLAT_TABLE_SIZE);
+static uint64_t base_table[XG_MAX_BASE_ENTRIES]
+	__aligned(XG_MAX_BASE_ENTRIES * sizeof(uint64_t));
+static mmap_region_t mmap[XLAT_GEN_MAX_REGIONS + 1];
+static int mapped_regions[XLAT_GEN_MAX_TABLES];
+static xlat_ctx_t ctx;
+
+static bool ctx_defined;
+/* Number of tables used, allocated in order by the library */
+static int tables_used;
+static unsigned long long va_space_size, pa_space_size;
+static unsigned int regions_num;
+
+/* Position in the memory map being parsed, for error messages */
+static const char *map_name;
+static unsigned int map_line = 1U;
+
+static void __dead2 fail(const char *fmt, ...) __printflike(1, 2);
+
+static void fail(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	fprintf(stderr, "xlat_gen: ");
+	if (map_name != NULL) {
+		fprintf(stderr, "%s:%u: ", map_name, map_line);
+	}
+	vfprintf(stderr, fmt, ap);
+	fprintf(stderr, "\n");
+	va_end(ap);
+
+	exit(EXIT_FAILURE);
+}
+
+int xlat_gen_printf(const char *fmt, ...)
+{
+	va_list ap;
+	int ret = 0;
+
+	if (print_tables) {
+		va_start(ap, fmt);
+		ret = vprintf(fmt, ap);
+		va_end(ap);
+	}
+
+	return ret;
+}
+
+void xlat_gen_panic(void)
+{
+	fail("translation tables can't be built");
+}
+
+/* The library asserts on invalid regions, report where they come from */
+static void abort_handler(int sig)
+{
+	(void)sig;
+
+	if (map_name != NULL) {
+		fprintf(stderr, "xlat_gen: %s:%u: invalid memory map\n",
+			map_name, map_line);
+	}
+}
+
+static void *read_file(const char *name)
+{
+	FILE *fp;
+	char *buf;
+	long size;
+
+	fp = fopen(name, "r");
+	if (fp == NULL) {
+		fail("can't open %s: %s", name, strerror(errno));
+	}
+
+	if ((fseek(fp, 0L, SEEK_END) != 0) || ((size = ftell(fp)) < 0) ||
+	    (fseek(fp, 0L, SEEK_SET) != 0)) {
+		fail("can't get the size of %s", name);
+	}
+
+	buf = malloc((size_t)size + 1U);
+	if (buf == NULL) {
+		fail("out of memory");
+	}
+
+	if (fread(buf, 1U, (size_t)size, fp) != (size_t)size) {
+		fail("can't read %s", name);
+	}
+
+	buf[size] = '\0';
+	fclose(fp);
+
+	return buf;
+}
+
+/* Load the symbols of the BL image, in the output format of nm */
+static void load_symbols(const char *name)
+{
+	char *buf = read_file(name);
+	char *line, *save;
+	symbol_t sym;
+	char type;
+
+	for (line = strtok_r(buf, "\n", &save); line != NULL;
+	     line = strtok_r(NULL, "\n", &save)) {
+		if (sscanf(line, "%llx %c %127s", &sym.value, &type,
+			   sym.name) != 3) {
+			/* Undefined symbols don't have a value */
+			continue;
+		}
+
+		symbols = realloc(symbols, (symbols_num + 1U) * sizeof(sym));
+		if (symbols == NULL) {
+			fail("out of memory");
+		}
+
+		symbols[symbols_num++] = sym;
+	}
+
+	free(buf);
+}
+
+static bool lookup(const char *name, unsigned long long *value)
+{
+	size_t i;
+
+	for (i = 0U; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+		if (strcmp(builtins[i].name, name) == 0) {
+			*value = builtins[i].value;
+			return true;
+		}
+	}
+
+	for (i = 0U; i < symbols_num; i++) {
+		if (strcmp(symbols[i].name, name) == 0) {
+			*value = symbols[i].value;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ * Parser of the memory map
+ ******************************************************************************/
+
+static const char *cur;
+
+static void skip_space(void)
+{
+	while ((*cur != '\0') && isspace((unsigned char)*cur)) {
+		if (*cur == '\n') {
+			map_line++;
+		}
+		cur++;
+	}
+}
+
+static bool accept(const char *op)
+{
+	size_t len = strlen(op);
+
+	skip_space();
+	if (strncmp(cur, op, len) != 0) {
+		return false;
+	}
+
+	/* Don't take the first character of a longer operator */
+	if ((len == 1U) && (strchr("<>&|=", op[0]) != NULL) &&
+	    (cur[1] == op[0])) {
+		return false;
+	}
+
+	cur += len;
+	return true;
+}
+
+static void expect(const char *op)
+{
+	if (!accept(op)) {
+		fail("expected '%s'", op);
+	}
+}
+
+static bool parse_ident(char *name, size_t size)
+{
+	size_t len = 0U;
+
+	skip_space();
+	if (!isalpha((unsigned char)*cur) && (*cur != '_')) {
+		return false;
+	}
+
+	while (isalnum((unsigned char)*cur) || (*cur == '_')) {
+		if (len == (size - 1U)) {
+			fail("identifier too long");
+		}
+		name[len++] = *cur++;
+	}
+	name[len] = '\0';
+
+	return true;
+}
+
+static unsigned long long parse_expr(void);
+
+static unsigned long long parse_primary(void)
+{
+	char name[SYM_NAME_LEN];
+	unsigned long long value;
+	char *end;
+
+	skip_space();
+
+	if (accept("(")) {
+		value = parse_expr();
+		expect(")");
+		return value;
+	}
+
+	if (isdigit((unsigned char)*cur)) {
+		errno = 0;
+		value = strtoull(cur, &end, 0);
+		if (errno != 0) {
+			fail("invalid number");
+		}
+
+		/* Skip integer suffixes */
+		cur = end;
+		while ((*cur == 'u') || (*cur == 'U') ||
+		       (*cur == 'l') || (*cur == 'L')) {
+			cur++;
+		}
+
+		return value;
+	}
+
+	if (parse_ident(name, sizeof(name))) {
+		if (!lookup(name, &value)) {
+			fail("unknown identifier '%s'", name);
+		}
+		return value;
+	}
+
+	fail("expected an expression");
+}
+
+static unsigned long long parse_unary(void)
+{
+	if (accept("-")) {
+		return -parse_unary();
+	} else if (accept("+")) {
+		return parse_unary();
+	} else if (accept("~")) {
+		return ~parse_unary();
+	} else if (accept("!")) {
+		return (parse_unary() == 0ULL) ? 1ULL : 0ULL;
+	}
+
+	return parse_primary();
+}
+
+/* Binary operators, from the lowest to the highest precedence */
+static const char * const binary_ops[][4] = {
+	{ "||" },
+	{ "&&" },
+	{ "|" },
+	{ "^" },
+	{ "&" },
+	{ "==", "!=" },
+	{ "<=", ">=", "<", ">" },
+	{ "<<", ">>" },
+	{ "+", "-" },
+	{ "*", "/", "%" },
+};
+
+#define BINARY_LEVELS	(sizeof(binary_ops) / sizeof(binary_ops[0]))
+
+static unsigned long long apply(const char *op, unsigned long long a,
+				unsigned long long b)
+{
+	if (((strcmp(op, "/") == 0) || (strcmp(op, "%") == 0)) && (b == 0ULL)) {
+		fail("division by zero");
+	}
+
+	switch (op[0]) {
+	case '|': return (op[1] == '|') ? (a || b) : (a | b);
+	case '&': return (op[1] == '&') ? (a && b) : (a & b);
+	case '^': return a ^ b;
+	case '=': return a == b;
+	case '!': return a != b;
+	case '<':
+		if (op[1] == '<') {
+			return a << b;
+		}
+		return (op[1] == '=') ? (a <= b) : (a < b);
+	case '>':
+		if (op[1] == '>') {
+			return a >> b;
+		}
+		return (op[1] == '=') ? (a >= b) : (a > b);
+	case '+': return a + b;
+	case '-': return a - b;
+	case '*': return a * b;
+	case '/': return a / b;
+	default: return a % b;
+	}
+}
+
+static unsigned long long parse_binary(unsigned int level)
+{
+	unsigned long long value, rhs;
+	const char *op;
+	unsigned int i;
+	bool found;
+
+	if (level == BINARY_LEVELS) {
+		return parse_unary();
+	}
+
+	value = parse_binary(level + 1U);
+
+	do {
+		found = false;
+		for (i = 0U; (i < 4U) && (binary_ops[level][i] != NULL); i++) {
+			op = binary_ops[level][i];
+			if (accept(op)) {
+				rhs = parse_binary(level + 1U);
+				value = apply(op, value, rhs);
+				found = true;
+				break;
+			}
+		}
+	} while (found);
+
+	return value;
+}
+
+static unsigned long long parse_expr(void)
+{
+	unsigned long long cond = parse_binary(0U);
+	unsigned long long a, b;
+
+	if (!accept("?")) {
+		return cond;
+	}
+
+	a = parse_expr();
+	expect(":");
+	b = parse_expr();
+
+	return (cond != 0ULL) ? a : b;
+}
+
+static unsigned int parse_args(unsigned long long *args, unsigned int max)
+{
+	unsigned int n = 0U;
+
+	expect("(");
+	do {
+		if (n == max) {
+			fail("too many arguments");
+		}
+		args[n++] = parse_expr();
+	} while (accept(","));
+	expect(")");
+
+	return n;
+}
+
+static void add_region(unsigned long long pa, unsigned long long va,
+		       unsigned long long size, unsigned long long attr,
+		       unsigned long long granularity)
+{
+	mmap_region_t mm = MAP_REGION_FULL_SPEC(pa, (uintptr_t)va,
+						(size_t)size, (unsigned int)attr,
+						(size_t)granularity);
+
+	if (!ctx_defined) {
+		fail("xlat_context() must come before the regions");
+	}
+
+	if (regions_num == XLAT_GEN_MAX_REGIONS) {
+		fail("too many regions");
+	}
+
+	if (attr > UINT32_MAX) {
+		fail("invalid attributes 0x%llx", attr);
+	}
+
+	/* Empty regions are ignored at run time too */
+	if (size == 0ULL) {
+		return;
+	}
+
+	mmap_add_region_ctx(&ctx, &mm);
+	regions_num++;
+}
+
+static void parse_map(const char *name)
+{
+	char *buf = read_file(name);
+	char stmt[SYM_NAME_LEN];
+	unsigned long long args[5];
+	unsigned int n;
+
+	map_name = name;
+	cur = buf;
+
+	for (;;) {
+		skip_space();
+
+		/* Separators of region lists are accepted and ignored */
+		while (accept(",") || accept(";")) {
+			skip_space();
+		}
+
+		if (*cur == '\0') {
+			break;
+		}
+
+		if (!parse_ident(stmt, sizeof(stmt))) {
+			fail("expected a statement");
+		}
+
+		n = parse_args(args, 5U);
+
+		if (strcmp(stmt, "xlat_context") == 0) {
+			if ((n != 3U) || ctx_defined) {
+				fail("invalid xlat_context()");
+			}
+
+			va_space_size = args[0];
+			pa_space_size = args[1];
+			if ((va_space_size == 0ULL) ||
+			    (va_space_size > MAX_VIRT_ADDR_SPACE_SIZE) ||
+			    ((va_space_size & (va_space_size - 1ULL)) != 0ULL) ||
+			    (GET_NUM_BASE_LEVEL_ENTRIES(va_space_size) >
+			     XG_MAX_BASE_ENTRIES) ||
+			    (pa_space_size == 0ULL)) {
+				fail("invalid address space sizes");
+			}
+
+			if (args[2] == EL1_EL0_REGIME) {
+				xlat_gen_current_el = 1U;
+			} else if (args[2] == EL2_REGIME) {
+				xlat_gen_current_el = 2U;
+			} else if (args[2] == EL3_REGIME) {
+				xlat_gen_current_el = 3U;
+			} else {
+				fail("invalid translation regime");
+			}
+
+			xlat_setup_dynamic_ctx(&ctx, pa_space_size - 1ULL,
+					       va_space_size - 1ULL, mmap,
+					       XLAT_GEN_MAX_REGIONS,
+					       (uint64_t **)tables,
+					       XLAT_GEN_MAX_TABLES, base_table,
+					       (int)args[2], mapped_regions);
+			ctx_defined = true;
+		} else if ((strcmp(stmt, "MAP_REGION_FLAT") == 0) &&
+			   (n == 3U)) {
+			add_region(args[0], args[0], args[1], args[2],
+				   REGION_DEFAULT_GRANULARITY);
+		} else if ((strcmp(stmt, "MAP_REGION") == 0) && (n == 4U)) {
+			add_region(args[0], args[1], args[2], args[3],
+				   REGION_DEFAULT_GRANULARITY);
+		} else if ((strcmp(stmt, "MAP_REGION2") == 0) && (n == 5U)) {
+			add_region(args[0], args[1], args[2], args[3], args[4]);
+		} else {
+			fail("invalid statement '%s'", stmt);
+		}
+	}
+
+	if (!ctx_defined) {
+		fail("missing xlat_context()");
+	}
+
+	map_name = NULL;
+	free(buf);
+}
+
+/*******************************************************************************
+ * Output of the translation context
+ ******************************************************************************/
+
+static int table_index(uint64_t desc)
+{
+	uintptr_t addr = (uintptr_t)(desc & TABLE_ADDR_MASK);
+	uintptr_t first = (uintptr_t)tables;
+
+	if ((desc & ~TABLE_ADDR_MASK) != TABLE_DESC) {
+		fail("unexpected table descriptor 0x%llx",
+		     (unsigned long long)desc);
+	}
+
+	if ((addr < first) ||
+	    (addr >= (first + (uintptr_t)tables_used * XLAT_TABLE_SIZE))) {
+		fail("table descriptor outside of the tables");
+	}
+
+	return (int)((addr - first) / XLAT_TABLE_SIZE);
+}
+
+/*
+ * Print the entries of a table. Table descriptors are emitted as the address
+ * of the table they point to, to be relocated by the linker.
+ */
+static void print_entries(FILE *out, const char *indent,
+			  const uint64_t *table, unsigned int entries,
+			  unsigned int level)
+{
+	uint64_t desc;
+	unsigned int i;
+
+	for (i = 0U; i < entries; i++) {
+		desc = table[i];
+		if (desc == INVALID_DESC) {
+			continue;
+		}
+
+		if ((level < XLAT_TABLE_LEVEL_MAX) &&
+		    ((desc & DESC_MASK) == TABLE_DESC)) {
+			fprintf(out, "%s[%u] = XLAT_PREBUILT_TABLE_DESC(%d),\n",
+				indent, i, table_index(desc));
+		} else {
+			fprintf(out, "%s[%u] = ULL(0x%016llx),\n", indent, i,
+				(unsigned long long)desc);
+		}
+	}
+}
+
+/* Find the level of the tables, by walking them from the base table */
+static void get_levels(const uint64_t *table, unsigned int entries,
+		       unsigned int level, unsigned int *levels)
+{
+	unsigned int i;
+	int idx;
+
+	if (level == XLAT_TABLE_LEVEL_MAX) {
+		return;
+	}
+
+	for (i = 0U; i < entries; i++) {
+		if ((table[i] & DESC_MASK) != TABLE_DESC) {
+			continue;
+		}
+
+		idx = table_index(table[i]);
+		levels[idx] = level + 1U;
+		get_levels(tables[idx], XLAT_TABLE_ENTRIES, level + 1U, levels);
+	}
+}
+
+static void emit(FILE *out, const char *map, bool stub)
+{
+	unsigned int levels[XLAT_GEN_MAX_TABLES];
+	const mmap_region_t *mm;
+	int i;
+
+	fprintf(out,
+		"/*\n"
+		" * Translation context generated by xlat_gen%s%s. Do not edit.\n"
+		" */\n\n"
+		"#include <platform_def.h>\n\n"
+		"#include <lib/cassert.h>\n"
+		"#include <lib/utils_def.h>\n"
+		"#include <lib/xlat_tables/xlat_tables_v2.h>\n\n",
+		stub ? "" : " from ", stub ? "" : map);
+
+	fprintf(out,
+		"#define XLAT_PREBUILT_TABLES\t%d\n"
+		"#define XLAT_PREBUILT_REGIONS\t%u\n\n"
+		"CASSERT(XLAT_PREBUILT_TABLES <= MAX_XLAT_TABLES,\n"
+		"\tassert_xlat_prebuilt_tables);\n"
+		"CASSERT(XLAT_PREBUILT_REGIONS <= MAX_MMAP_REGIONS,\n"
+		"\tassert_xlat_prebuilt_regions);\n",
+		tables_used, regions_num);
+
+	if (!stub) {
+		fprintf(out,
+			"CASSERT(PLAT_VIRT_ADDR_SPACE_SIZE == ULL(0x%llx),\n"
+			"\tassert_xlat_prebuilt_virt_addr_space_size);\n"
+			"CASSERT(PLAT_PHY_ADDR_SPACE_SIZE == ULL(0x%llx),\n"
+			"\tassert_xlat_prebuilt_phy_addr_space_size);\n",
+			va_space_size, pa_space_size);
+	}
+
+	/*
+	 * Tables that are only used for the static regions can't be modified,
+	 * they are made read-only.
+	 */
+	fprintf(out,
+		"\n#if PLAT_XLAT_TABLES_DYNAMIC\n"
+		"#define XLAT_PREBUILT_TABLE_CONST\n"
+		"#define XLAT_PREBUILT_TABLE_SECTION\t\".data.xlat_prebuilt\"\n"
+		"#else\n"
+		"#define XLAT_PREBUILT_TABLE_CONST\tconst\n"
+		"#define XLAT_PREBUILT_TABLE_SECTION\t\".rodata.xlat_prebuilt\"\n"
+		"#endif\n\n"
+		"#define XLAT_PREBUILT_TABLE_DESC(_idx)\t\\\n"
+		"\t((uint64_t)(uintptr_t)tf_xlat_tables[_idx] + TABLE_DESC)\n\n");
+
+	fprintf(out,
+		"static XLAT_PREBUILT_TABLE_CONST uint64_t\n"
+		"tf_xlat_tables[MAX_XLAT_TABLES][XLAT_TABLE_ENTRIES]\n"
+		"\t__aligned(XLAT_TABLE_SIZE)\n"
+		"\t__section(XLAT_PREBUILT_TABLE_SECTION) = {\n");
+
+	(void)memset(levels, 0, sizeof(levels));
+	get_levels(base_table, ctx.base_table_entries, ctx.base_level, levels);
+
+	for (i = 0; i < tables_used; i++) {
+		fprintf(out, "\t[%d] = {\t/* Level %u */\n", i, levels[i]);
+		print_entries(out, "\t\t", tables[i], XLAT_TABLE_ENTRIES,
+			      levels[i]);
+		fprintf(out, "\t},\n");
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out,
+		"static XLAT_PREBUILT_TABLE_CONST uint64_t\n"
+		"tf_base_xlat_table[GET_NUM_BASE_LEVEL_ENTRIES(PLAT_VIRT_ADDR_SPACE_SIZE)]\n"
+		"\t__aligned(GET_NUM_BASE_LEVEL_ENTRIES(PLAT_VIRT_ADDR_SPACE_SIZE) *\n"
+		"\t\t  sizeof(uint64_t))\n"
+		"\t__section(XLAT_PREBUILT_TABLE_SECTION) = {\n");
+	if (!stub) {
+		print_entries(out, "\t", base_table, ctx.base_table_entries,
+			      ctx.base_level);
+	}
+	fprintf(out, "};\n\n");
+
+	/* Regions, in the order in which they have been sorted */
+	fprintf(out,
+		"static mmap_region_t tf_mmap[MAX_MMAP_REGIONS + 1]\n"
+		"\t__section(\".data.xlat_prebuilt\") = {\n");
+	for (mm = mmap; mm->size != 0U; mm++) {
+		fprintf(out,
+			"\tMAP_REGION_FULL_SPEC(ULL(0x%llx), UL(0x%lx), UL(0x%zx),\n"
+			"\t\t\t     U(0x%x), UL(0x%zx)),\n",
+			mm->base_pa, mm->base_va, mm->size, mm->attr,
+			mm->granularity);
+	}
+	fprintf(out, "};\n\n");
+
+	fprintf(out,
+		"#if PLAT_XLAT_TABLES_DYNAMIC\n"
+		"static int tf_mapped_regions[MAX_XLAT_TABLES]\n"
+		"\t__section(\".data.xlat_prebuilt\") = {\n");
+	for (i = 0; i < tables_used; i++) {
+		fprintf(out, "\t[%d] = %d,\n", i, mapped_regions[i]);
+	}
+	fprintf(out, "};\n#endif\n\n");
+
+	fprintf(out,
+		"xlat_ctx_t tf_xlat_ctx __section(\".data.xlat_prebuilt\") = {\n"
+		"\t.pa_max_address = PLAT_PHY_ADDR_SPACE_SIZE - 1ULL,\n"
+		"\t.va_max_address = PLAT_VIRT_ADDR_SPACE_SIZE - 1UL,\n"
+		"\t.mmap = tf_mmap,\n"
+		"\t.mmap_num = MAX_MMAP_REGIONS,\n"
+		"\t.tables = (uint64_t (*)[XLAT_TABLE_ENTRIES])tf_xlat_tables,\n"
+		"\t.tables_num = MAX_XLAT_TABLES,\n"
+		"#if PLAT_XLAT_TABLES_DYNAMIC\n"
+		"\t.tables_mapped_regions = tf_mapped_regions,\n"
+		"#endif\n"
+		"\t.next_table = XLAT_PREBUILT_TABLES,\n"
+		"\t.base_table = (uint64_t *)tf_base_xlat_table,\n"
+		"\t.base_table_entries = ARRAY_SIZE(tf_base_xlat_table),\n"
+		"\t.max_pa = ULL(0x%llx),\n"
+		"\t.max_va = UL(0x%lx),\n"
+		"\t.base_level = GET_XLAT_TABLE_LEVEL_BASE(PLAT_VIRT_ADDR_SPACE_SIZE),\n"
+		"\t.initialized = false,\n"
+		"\t.xlat_regime = %s,\n"
+		"};\n",
+		ctx.max_pa, ctx.max_va,
+		(ctx.xlat_regime == EL1_EL0_REGIME) ? "EL1_EL0_REGIME" :
+		(ctx.xlat_regime == EL2_REGIME) ? "EL2_REGIME" : "EL3_REGIME");
+}
+
+static void usage(void)
+{
+	printf("usage: xlat_gen [-b] [-p] [-s symbols] -o output [map]\n\n"
+	       "Generate the translation tables of the memory map 'map'.\n"
+	       "Without 'map', a stub with the same layout but no regions is\n"
+	       "generated.\n\n"
+	       "  -b            The target implements BTI\n"
+	       "  -o output     Output C source file\n"
+	       "  -p            Print the mmap and the tables, in the format\n"
+	       "                used by the firmware in verbose builds\n"
+	       "  -s symbols    Symbols of the BL image, as printed by nm\n");
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *output = NULL;
+	const char *map = NULL;
+	FILE *out;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "bo:ps:h")) != -1) {
+		switch (opt) {
+		case 'b':
+			xlat_gen_bti = true;
+			break;
+		case 'o':
+			output = optarg;
+			break;
+		case 'p':
+			print_tables = true;
+			break;
+		case 's':
+			load_symbols(optarg);
+			break;
+		default:
+			usage();
+		}
+	}
+
+	if ((output == NULL) || ((argc - optind) > 1)) {
+		usage();
+	}
+
+	if (optind < argc) {
+		map = argv[optind];
+	}
+
+	(void)signal(SIGABRT, abort_handler);
+
+	if (map != NULL) {
+		parse_map(map);
+		init_xlat_tables_ctx(&ctx);
+
+		/*
+		 * The library is built with support for dynamic regions, in
+		 * which case the tables in use are those that map regions.
+		 */
+		while ((tables_used < XLAT_GEN_MAX_TABLES) &&
+		       (mapped_regions[tables_used] != 0)) {
+			tables_used++;
+		}
+	} else {
+		/* Empty context, only the layout of the output matters */
+		ctx.base_level = XLAT_TABLE_LEVEL_MAX;
+		ctx.xlat_regime = EL3_REGIME;
+		ctx.mmap = mmap;
+	}
+
+	out = fopen(output, "w");
+	if (out == NULL) {
+		fail("can't open %s: %s", output, strerror(errno));
+	}
+
+	emit(out, map, map == NULL);
+
+	if (fclose(out) != 0) {
+		fail("can't write %s", output);
+	}
+
+	return 0;
+}